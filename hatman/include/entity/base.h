@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint> // fixed-size ints (entity handles)
+#include <limits> // invalid handle index
 #include <memory> // types
 
 #include "utility/geometry.h" // types
@@ -31,6 +33,19 @@ namespace ntt {
 	};
 
 
+	// # EntityHandle #
+	// - Stable reference to an entity owned by a level
+	// - Handle of an erased entity becomes stale and no longer resolves, even if
+	//   its slot gets reused by another entity (slots are versioned with generations)
+	struct EntityHandle {
+		std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t generation = 0;
+
+		bool operator==(const EntityHandle &other) const { return this->index == other.index && this->generation == other.generation; }
+		bool operator!=(const EntityHandle &other) const { return !(*this == other); }
+	};
+
+
 	// # Entity #
 	// - ABSTRACT
 	// - Base class for all entity types
@@ -45,16 +60,26 @@ namespace ntt {
 
 		virtual TypeId type_id() const = 0; // MUST be overriden for ALL derived classes
 
-		virtual bool update(Milliseconds elapsedTime); // updates all logic, returns this->enabled
+		virtual bool update(Milliseconds elapsedTime); // updates all logic except for physics, returns this->enabled
 		virtual void draw() const; // draws a correct frame of current animation
 
+		virtual bool physics_active() const;
+			// level updates solids of active entities before calling 'update()', possibly from worker threads,
+			// false for disabled entities and entities without a solid
+
 		void mark_for_erase(); // instantly disables entity and marks for erasion
 		void mark_for_erase(Milliseconds delay); // marks entity for erasion after a delay
 
 		bool marked_for_erase() const; // returns whether entity should be erased
+		Milliseconds erase_delay() const; // delay passed to 'mark_for_erase()', 0 if erase wasn't delayed
+
+		void teleport(const Vector2d &newPosition);
+			// instantly moves entity, use instead of assigning 'position' for moves that aren't simulated movement,
+			// drawing and camera don't interpolate across the jump
 
 
 		Vector2d position; // position in a level
+		Vector2d position_previous; // position before the last simulation step, drawing is interpolated between the two
 
 		std::unique_ptr<Sprite> sprite;
 		std::unique_ptr<SolidRectangle> solid;
@@ -62,6 +87,8 @@ namespace ntt {
 
 		bool enabled; // entity doesn't update/draw if disabled
 
+		EntityHandle handle; // assigned by a level upon insertion
+
 	protected:
 		std::unique_ptr<Timer> erase_timer; // if exists and finished => entity should be erased
 
@@ -73,8 +100,4 @@ namespace ntt {
 			// 'folder' refers to folder in ./content/textures/entitites/, no need to write full path
 			// 'filename' does NOT include file extension
 	};
-}
-
-
-
-Animation _parse_animation(const std::string &path);
\ No newline at end of file
+}
\ No newline at end of file
@@ -89,6 +89,7 @@ namespace ntt::m_type {
 
 	protected:
 		Creature* target; // nullptr when enemy is not aggro'ed
+		EntityHandle target_handle; // used to detect that target was erased, 'target' is dangling in that case
 		Vector2d target_relative_pos; // store here so we don't have to recalculate it constantly
 
 		virtual bool aggroCondition(Creature* creature) = 0;
@@ -32,6 +32,7 @@ namespace ntt::s_type {
 		TypeId type_id() const override;
 
 		bool update(Milliseconds elapsedTime) override;
+		bool physics_active() const override; // delayed projectiles don't move
 
 		Timer delay; // stops projectile logic when this timer is set
 
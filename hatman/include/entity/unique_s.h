@@ -44,20 +44,4 @@ namespace ntt::s {
 			void onCollision() override;
 		};
 	}
-
-
-
-	namespace particle {
-		// # OnDeathParticle #
-		// - Single pixel particle
-		class OnDeathParticle : public s_type::Particle {
-		public:
-			OnDeathParticle() = delete;
-
-			OnDeathParticle(const Vector2d &position, const Vector2d &speed, const RGBColor &color, Milliseconds lifetime);
-
-		private:
-			RGBColor color;
-		};
-	}
 }
\ No newline at end of file
@@ -26,7 +26,10 @@ public:
 	Vector2d get_ScreenPos_from_LevelPos(const Vector2d &levelPos) const;
 	Vector2d get_LevelPos_from_ScreenPos(const Vector2d &screenPos) const;
 
-	void draw_sprite(sf::Sprite &sprite);
+	sf::View get_view() const; // view that maps FOV onto the window, set once per world pass
+
+	void draw_sprite(sf::Sprite &sprite); // queues sprite into the world pass
+	void draw_vertices(const sf::VertexArray &vertices, const sf::Texture* texture); // vertices are in level coords
 
 	Vector2d position;
 
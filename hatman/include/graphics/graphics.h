@@ -2,6 +2,7 @@
 
 #include <SFML/Graphics.hpp>
 
+#include <array> // related type (batches per pass)
 #include <unordered_map> // related type
 #include <memory> // 'unique_ptr' type
 #include <string> // related type
@@ -10,6 +11,8 @@
 #include "utility/launch_info.h" // 'LaunchInfo' class
 #include "graphics/gui.h" // 'Gui' module
 #include "graphics/camera.h" // 'Camera' module
+#include "graphics/sprite_batch.h" // 'SpriteBatch' class
+#include "graphics/texture_atlas.h" // 'TextureAtlas' class, 'TextureRegion' type
 
 
 
@@ -18,9 +21,38 @@ class Camera;
 
 
 
+// # RenderPass #
+// - Passes are flushed in the order of declaration
+// - View is set only once per pass
+enum class RenderPass {
+	BACKGROUND, // uses overlay view, drawn below everything else
+	WORLD, // uses camera view, sorted by layer and texture
+	OVERLAY // uses natural-resolution view, keeps submission order
+};
+
+constexpr size_t RENDER_PASS_COUNT = 3;
+
+
+
+// world_layers::
+// - Draw order of the world pass, quads inside the same layer get sorted by texture
+namespace world_layers {
+	constexpr int TILES_BACKLAYER = 0;
+	constexpr int TILES = 1;
+	constexpr int ENTITIES = 2;
+	constexpr int ENTITY_EFFECTS = 3;
+	constexpr int HEALTHBARS = 4;
+	constexpr int TILES_FRONTLAYER = 5;
+	constexpr int DEBUG = 6;
+	constexpr int TEXT = 7;
+}
+
+
+
 // # Graphics #
 // - Can be accessed wherever #include'ed through static 'READ' and 'ACCESS' fields
 // - Handles window creation, rendering and loading of images
+// - Headless builds ('HATMAN_HEADLESS') never create a window or load images, queued geometry is discarded
 // - Only one instance at a time should exits (creation of new instances however is not controlled in any way)
 class Graphics {
 public:
@@ -44,11 +76,27 @@ public:
 	sf::Texture& getTexture_Background(const std::string &name);
 	sf::Texture& getTexture_GUI(const std::string &name);
 
+	TextureRegion getTextureRegion(const std::string &filePath); // region in the atlas, or the whole standalone texture
+	// Cases of getTextureRegion() (only these directories are packed into the atlas)
+	TextureRegion getTextureRegion_Entity(const std::string &name);
+	TextureRegion getTextureRegion_Item(const std::string &name);
+	TextureRegion getTextureRegion_GUI(const std::string &name);
+
 
 	
-	void window_clear();                         // 1) Clear window
-	void window_draw_sprite(sf::Sprite &sprite); // 2) Draw all sprites through Cameta and Gui
-	void window_display();                       // 3) Display drawn sprites
+	void window_clear();        // 1) Clear window
+	void begin_world_pass();    // 2) Set up views (once per frame, camera should already be in place)
+	void begin_overlay_pass();  //
+	                            // 3) Queue all sprites through Camera and Gui
+	void window_display();      // 4) Flush sprite batches and display drawn sprites
+
+	void queue_sprite(const sf::Sprite &sprite, RenderPass pass);
+	void queue_vertices(const sf::VertexArray &vertices, const sf::Texture* texture, RenderPass pass);
+
+	void set_layer(int layer); // layer used by the following world pass sprites (see 'world_layers::')
+	int get_layer() const;
+
+	size_t draw_calls() const; // draw calls issued by the last 'window_display()'
 	
 	int width() const;
 	int height() const;
@@ -65,6 +113,15 @@ private:
 	double rendering_scaling_factor; // == <renderingresolution> / <natural resolution>
 
 	std::unordered_map<std::string, sf::Texture> loadedTextures; // all loaded images are saved here
+	TextureAtlas atlas; // entity, item and GUI images packed upon creation
+
+	std::array<SpriteBatch, RENDER_PASS_COUNT> batches{ SpriteBatch(true), SpriteBatch(true), SpriteBatch(false) }; // indexed by 'RenderPass'
+	sf::View view_world;
+	sf::View view_overlay;
+
+	int world_layer = 0;
+
+	size_t last_draw_calls = 0;
 
 	///friend Game;
 };
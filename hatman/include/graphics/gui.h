@@ -12,6 +12,7 @@
 #include "entity/player.h" // 'Forms' enum
 #include "utility/color.hpp" // 'RGBColor' type
 #include "modules/sound.h" // 'Sound' type for GUI interactions
+#include "graphics/texture_atlas.h" // 'TextureRegion' type
 
 
 
@@ -21,7 +22,7 @@
 class Font {
 public:
 	Font() = delete;
-	Font(sf::Texture* texture, const Vector2 &size, const Vector2d &gap);
+	Font(const TextureRegion &region, const Vector2 &size, const Vector2d &gap);
 
 	Vector2d draw_symbol(const Vector2d &position, char symbol, bool overlay = true);
 		// returns position of character end (top-right corner)
@@ -49,6 +50,7 @@ public:
 	Vector2d get_font_monospace() const; // monospace == font_size + font_gap
 
 private:
+	TextureRegion texture_region;
 	sf::Sprite sprite;
 
 	Vector2 font_size; // size of 1 symbol on source texture
@@ -135,7 +137,7 @@ public:
 
 	GUI_FPSCounter(Font* font);
 
-	void update(Milliseconds elapsedTime);
+	void count_frame(Milliseconds frameTime); // called once per rendered frame, simulation can run several steps per frame
 	void draw() const;
 
 private:
@@ -347,6 +349,7 @@ public:
 	void draw();
 
 private:
+	TextureRegion texture_region;
 	sf::Sprite sprite;
 
 	double percentage;
@@ -363,6 +366,7 @@ public:
 	void draw();
 
 private:
+	TextureRegion texture_region;
 	sf::Sprite sprite;
 };
 
@@ -474,6 +478,7 @@ public:
 	// FPSCounter
 	void FPSCounter_on();
 	void FPSCounter_off();
+	void FPSCounter_countFrame(Milliseconds frameTime);
 
 	// Main menu
 	void MainMenu_on();
@@ -518,7 +523,9 @@ public:
 	void LevelName_off();
 
 	// General
-	void draw_sprite(sf::Sprite &sprite);
+	sf::View get_view() const; // natural-resolution view, set once per overlay pass
+
+	void draw_sprite(sf::Sprite &sprite); // queues sprite into the overlay pass
 
 private:
 	// GUI elements that do NOT need to remember internal state while changing visibility
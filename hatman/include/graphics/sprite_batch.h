@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <vector> // related type
+
+
+
+// # SpriteBatch #
+// - Collects textured quads together with their layer and color
+// - Upon flushing quads are sorted by layer and then by texture (sort is stable, so submission
+//   order is kept for quads that share both), after that every run of quads with the same texture
+//   is submitted as a single vertex array
+// - Batches created with 'sortByTexture == false' only sort by layer, which preserves
+//   painter's order of overlapping sprites (used by GUI), consecutive quads are still merged
+// - Prebuilt geometry (tile meshes) can be submitted as well, it is referenced and should outlive the frame
+class SpriteBatch {
+public:
+	SpriteBatch(bool sortByTexture = true);
+
+	void add_sprite(const sf::Sprite &sprite, int layer); // converts sprite to a quad (respects transform and color)
+	void add_vertices(const sf::VertexArray &vertices, const sf::Texture* texture, int layer); // 'vertices' should be 'sf::Quads'
+
+	void flush(sf::RenderTarget &target); // draws and clears all collected geometry
+	void clear(); // discards all collected geometry without drawing
+
+	size_t draw_calls() const; // number of draw calls issued by the last 'flush()'
+	size_t quad_count() const; // number of sprite quads submitted to the last 'flush()'
+
+private:
+	struct Item {
+		int layer;
+		const sf::Texture* texture;
+		size_t sequence; // submission order
+
+		size_t quad_index; // index of the first vertex in 'quads'
+		const sf::VertexArray* vertices; // if present, item is a prebuilt geometry instead of a quad
+	};
+
+	bool sort_by_texture;
+
+	std::vector<Item> items;
+	std::vector<sf::Vertex> quads; // vertices of all submitted sprite quads, 4 per quad
+	std::vector<sf::Vertex> run; // scratch buffer that gets filled by a single texture run
+
+	size_t last_draw_calls = 0;
+	size_t last_quad_count = 0;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <list> // related type (atlas pages)
+#include <string> // related type
+#include <unordered_map> // related type
+#include <vector> // related type
+
+#include "utility/geometry.h" // geometry types
+
+
+
+// # TextureRegion #
+// - Part of a texture that holds a single image
+// - Image can either occupy a whole texture or be packed into an atlas
+struct TextureRegion {
+	sf::Texture* texture = nullptr;
+	srcRect rect{};
+
+	void apply(sf::Sprite &sprite) const; // sets texture and source rect that covers the whole image
+
+	sf::IntRect subrect(const sf::IntRect &local) const; // converts rect in image coords to texture coords
+	srcRect subrect(const srcRect &local) const;
+};
+
+
+
+// # TextureAtlas #
+// - Packs all .png images from given directories into a few large textures upon startup
+// - Images are packed with simple shelf algorithm (tallest first), 1px of transparent padding
+//   is kept between images so neighbours don't bleed into each other
+// - Images that don't fit into max texture size are left out, 'Graphics' falls back
+//   to loading them as standalone textures
+class TextureAtlas {
+public:
+	TextureAtlas() = default;
+
+	void pack(const std::vector<std::string> &directories); // recursively collects images from directories
+
+	const TextureRegion* find(const std::string &filePath) const; // returns nullptr if image wasn't packed
+
+	size_t page_count() const;
+
+private:
+	std::list<sf::Texture> pages; // 'list' keeps texture addresses stable
+	std::unordered_map<std::string, TextureRegion> regions; // keyed by file path
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <vector> // related type
+
+#include "utility/geometry.h" // geometry types
+#include "modules/sprite.h" // 'Sprite' module (animated tiles)
+
+
+
+// # TileMesh #
+// - Geometry of a single tile layer baked into vertex arrays upon level load
+// - Layer is split into square chunks, each chunk holds a separate vertex array per texture
+// - Animated tiles get bound to a sprite and get their texture coords patched in place before drawing,
+//   mesh itself doesn't depend on tile objects, so it can outlive them and be rebound to new ones
+// - Draws only chunks that intersect given tile range
+class TileMesh {
+public:
+	TileMesh() = default;
+
+	void init(const Vector2 &mapSize); // allocates chunk grid for a map of given size (in tiles)
+
+	void add_tile(const Vector2 &index, const sf::Texture* texture, const srcRect &sourceRect, bool animated = false);
+	void bind_animated_sprite(const Vector2 &index, const Sprite* sprite);
+		// texture rect of a sprite is read upon drawing, animated tiles that aren't bound keep their current frame
+	void unbind_animated_sprites();
+
+	void draw(const Vector2 &cornerIndex, const Vector2 &endIndex); // both indexes are inclusive
+
+	size_t draw_calls() const; // number of draw calls issued by the last 'draw()'
+	size_t vertex_count() const;
+
+private:
+	struct Batch {
+		const sf::Texture* texture;
+		sf::VertexArray vertices;
+	};
+
+	struct AnimatedQuad {
+		size_t batch_index;
+		size_t vertex_index;
+		Vector2 tile_index;
+		const Sprite* sprite; // nullptr if not bound
+	};
+
+	struct Chunk {
+		std::vector<Batch> batches; // one batch per texture
+		std::vector<AnimatedQuad> animated_quads;
+	};
+
+	Chunk& getChunk(const Vector2 &chunkIndex);
+	Batch& getBatch(Chunk &chunk, const sf::Texture* texture, size_t &batchIndex); // creates batch if necessary
+
+	static void set_quad_texcoords(sf::Vertex* quad, const sf::IntRect &rect);
+
+	std::vector<Chunk> chunks; // indexed as 'X * chunk_grid_size.y + Y', same as tile layers
+	Vector2 chunk_grid_size;
+
+	size_t last_draw_calls = 0;
+};
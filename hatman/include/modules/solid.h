@@ -31,9 +31,24 @@ constexpr int operator & (SolidFlags flag1, SolidFlags flag2) {
 class Tile; // we need pointers to these
 namespace ntt { class Entity; }
 
+
+
+// # TileSweep #
+// - Result of sweeping a hitbox through tiles
+struct TileSweep {
+	double time_of_impact = 1.; // fraction of movement done before the hit, 1 if nothing was hit
+	Vector2d normal; // normal of the surface that was hit, zero if nothing was hit
+
+	bool hit() const { return this->time_of_impact < 1.; }
+};
+
+
+
 // # SolidRectangle #
 // - Represents a rectangle with physics attached to it
 // - Behaviour depends on active flags
+// - Solids that stay grounded and still for a while fall asleep and skip physics entirely,
+//   any force, impulse, external movement or loss of ground wakes them up
 class SolidRectangle {
 public:
 	SolidRectangle() = delete;
@@ -64,9 +79,19 @@ public:
 
 	bool is_dropping_down; // fall through platforms when true
 
+	bool is_sleeping; // physics is skipped while true
+
+	void wake(); // for changes solid can't notice on its own
+
 	// Checks/getters
 	dRect getHitbox() const;
-	Tile* getFirstCollision_Tile() const; // nullptr if no tile collisions were found
+	bool hasCollision_Tile() const;
+
+	TileSweep sweep_Tiles(const Vector2d &movement) const; // sweeps current hitbox
+	TileSweep sweep_Tiles(const dRect &hitbox, const Vector2d &movement) const;
+		// continuous check of hitbox moved by 'movement' against tile rects, returns the first time of impact
+		// - platforms only stop downwards movement (unless solid is dropping down)
+		// - rects that hitbox already overlaps are ignored, overlap resolution deals with them
 	ntt::Entity* getFirstCollision_DifferentFactionEntity(Faction faction) const; // ignores collisions with entities who have no .health or .solid
 
 	// Force
@@ -99,9 +124,16 @@ public:
 private:
 	Vector2d total_force;
 	bool friction_compensated; // when true friction is not applied
+
+	int resting_steps; // steps spent grounded and still in a row
+	Vector2d sleep_position; // position at the moment solid fell asleep
 	
 	void apply_GravityForce(); // applies gravity as a downwards force
 	void apply_FrictionForce(); // all grounded object experience friction force
 	void apply_TileCollisions();
+	void apply_SweptTileCollisions(); // cuts fast movement short of the first obstacle
 	void apply_LevelBorderCollisions();
+
+	bool _isDisturbed() const; // checks if sleeping solid should wake up
+	void _updateSleep(); // puts solid to sleep once it rested long enough
 };
\ No newline at end of file
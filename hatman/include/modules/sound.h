@@ -8,6 +8,10 @@
 
 
 
+// # Sound #
+// - Playback timing is tracked with a simulation 'Timer' in every build, gameplay (like erasing entities
+//   once their sounds end) depends on it, so it must not depend on the audio device or wall-clock time
+// - Headless builds ('HATMAN_HEADLESS') only emulate playback timing
 class Sound {
 public:
 	Sound() = delete;
@@ -24,5 +28,9 @@ public:
 	// some things need duration to deduce when the sound can be destoyed
 
 private:
+#ifndef HATMAN_HEADLESS
 	sf::Sound sound;
+#endif
+	Milliseconds duration;
+	Timer playback;
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <string> // related type
 #include <initializer_list> // related type
 #include <unordered_map> // related type
+#include <vector> // related type
+#include <memory> // 'shared_ptr' type (shared frame data)
 
 
 #include "systems/timer.h" // 'Milliseconds' type
@@ -28,6 +30,7 @@ struct AnimationFrame {
 // # Animation #
 // - Contains frames of an animation and delays between these frames
 // - Does NOT handle time recording, updating of frame indexes and etc
+// - Frame data is immutable and shared between copies, copying an animation is cheap
 struct Animation {
 	Animation() = default;
 
@@ -40,8 +43,33 @@ struct Animation {
 
 	size_t lastIndex() const;
 
+	const AnimationFrame& frame(size_t index) const;
+	const std::vector<AnimationFrame>& getFrames() const;
+
 	sf::Texture* texture;
-	std::vector<AnimationFrame> frames; // holds source rectangles and display time of all frames of animation
+	std::shared_ptr<const std::vector<AnimationFrame>> frames; // holds source rectangles and display time of all frames of animation
+};
+
+
+
+// # AnimationStorage #
+// - Can be accessed wherever #include'ed through static 'READ' and 'ACCESS' fields
+// - Parses animations from Aseprite .JSON on the first request, later requests return a copy that
+//   shares frame data with the cached one, which makes sprite creation free of any file IO
+// - Only one instance at a time should exits logically, but more can be created
+class AnimationStorage {
+public:
+	AnimationStorage();
+
+	static const AnimationStorage* READ;
+	static AnimationStorage* ACCESS;
+
+	Animation getAnimation(const std::string &path); // loads or returns a loaded animation, 'path' does NOT include extension
+
+private:
+	std::unordered_map<std::string, Animation> loadedAnimations;
+
+	Animation parseFromJSON(const std::string &path) const;
 };
 
 enum class Flip {
@@ -67,6 +95,8 @@ public:
 
 	void setRotation(double radians);
 	void setRotationDegrees(double degrees);
+
+	const sf::IntRect& getTextureRect() const; // source rect of the frame that is currently displayed
 	
 	Vector2d alignment;
 	Flip flip = Flip::NONE; // change to flip textures
@@ -6,6 +6,7 @@
 
 #include "utility/geometry.h" // 'Vector2d' and 'srcRect' types for 'HealthbarDisplay'
 #include "systems/timer.h" // 'Milliseconds' type for updating
+#include "graphics/texture_atlas.h" // 'TextureRegion' type
 
 
 using uint = unsigned int; // typedefs for convenient future refactioring
@@ -189,6 +190,7 @@ private:
 
 	Vector2d corner_alignment; // alignment relative to the .parent_position
 
+	TextureRegion texture_region;
 	sf::Sprite sprite;
 };
 
@@ -209,5 +211,6 @@ private:
 	const Health &parent_health;
 	std::string boss_title;
 
+	TextureRegion texture_region;
 	sf::Sprite sprite;
 };
\ No newline at end of file
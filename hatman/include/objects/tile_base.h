@@ -34,7 +34,8 @@ struct TileHitboxRect {
 
 // # TileHitbox #
 // - Contains rectangles that make up a tile hitbox
-// - Used to store tile info inside a tileset
+// - Used to store tile info inside a tileset, rects are in tile-local coordinates
+// - Stored once per tileset and shared by all cells that use the tile
 struct TileHitbox {
 	TileHitbox() {};
 
@@ -75,6 +76,8 @@ struct TileInteraction {
 // - NOT abstract (unlike 'Entity' and 'Item')
 // - Holds necessary info about a single tile
 // - Created by pulling data from tilesets by tile ID
+// - Only animated and interactive tiles get their own objects, static tiles are
+//   stored by the level as tile ids that reference shared tileset data
 class Tile {
 public:
 	Tile() = delete;
@@ -96,14 +99,11 @@ public:
 
 	Vector2d position; // position on the level
 
-	std::unique_ptr<TileHitbox> hitbox; // contains a vector of hitbox Rectangle's
 	std::unique_ptr<Sprite> sprite; // animated or static
 	std::unique_ptr<TileInteraction> interaction; // Unique logic for derived classes
 
 protected:
 	bool toggle_active;
-
-	sf::Sprite tilesheet_sprite;
 };
 
 
@@ -132,6 +132,7 @@ public:
 	bool has_entity_spawn_data(int tileId) const;
 
 	TileHitbox get_tile_hitbox(int tileId) const; // returns tile hitbox on the map
+	const TileHitbox* find_tile_hitbox(int tileId) const; // shared hitbox, nullptr if tile has none
 	Animation get_tile_animation(int tileId) const;
 	TileInteraction get_tile_interaction(int tileId) const; // should only be used when hit/actionbox is present
 	const EntitySpawnData& get_entity_spawn_data(int tileId) const;
@@ -140,8 +141,6 @@ public:
 	std::string tileset_get_filename() const;
 	sf::Texture* tileset_get_texture() const;
 
-	int first_gid;
-
 private:
 	std::string filename;
 
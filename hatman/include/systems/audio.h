@@ -9,6 +9,9 @@
 
 
 
+// # Audio #
+// - Can be accessed wherever #include'ed through static 'READ' and 'ACCESS' fields
+// - Headless builds ('HATMAN_HEADLESS') don't open an audio device, only sound durations are known
 class Audio {
 public:
     Audio(int music_volume_setting, int sound_volume_setting);
@@ -19,7 +22,11 @@ public:
     static Audio*       ACCESS;
     
     // - Sounds -
+#ifndef HATMAN_HEADLESS
     const sf::SoundBuffer& getSoundBuffer(const std::string& name);
+#endif
+    Milliseconds getSoundDuration(const std::string& name);
+        // reads file header, nothing gets decoded, same value in every build since gameplay timing depends on it
 
     // - Music -
     void queue_music(const std::string& name);
@@ -43,8 +50,11 @@ private:
     Timer music_fade_out_timer;
     Timer music_fade_in_timer;
 
+#ifndef HATMAN_HEADLESS
     sf::Music music;
 
     std::unordered_map<std::string, sf::SoundBuffer> loadedAudio; // all loaded sounds are saved here
                                                                   // (except music which is streamed directly from file)
+#endif
+    std::unordered_map<std::string, Milliseconds> loadedDurations;
 };
\ No newline at end of file
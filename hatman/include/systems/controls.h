@@ -15,6 +15,7 @@ public:
 	sf::Mouse::Button LMB;
 	sf::Keyboard::Key ESC;
 	sf::Keyboard::Key F3;
+	sf::Keyboard::Key F4; // toggles frame profiler
 
 	// Game controls
 	sf::Keyboard::Key LEFT;
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array> // related type
+#include <cstdint> // fixed-size ints
+#include <limits> // invalid indices
+#include <memory> // related type
+#include <vector> // related type
+
+#include "entity/base.h" // 'Entity', 'EntityHandle' types
+#include "systems/flags.h" // 'Flag' type
+
+
+
+// # EntityGroup #
+// - Categories entities can be accessed by
+// - 'KILLABLE' == 'has .solid' + 'has .health'
+// - Type groups follow 'TypeId' hierarchy ('ENEMY' and 'PLAYER' are also 'CREATURE')
+enum class EntityGroup {
+	SOLID,
+	KILLABLE,
+	CREATURE,
+	ENEMY,
+	ITEM_ENTITY,
+	DESTRUCTIBLE,
+	PROJECTILE,
+	PARTICLE
+};
+
+constexpr size_t ENTITY_GROUP_COUNT = 8;
+
+
+
+// # EntityRegistry #
+// - Owns all entities of a level, hands out generational handles
+// - Entities are stored densely, slots map handles to their dense positions
+// - Every group is a dense array of pointers, slots remember positions in groups
+//   so insertion and erasion are O(1) swap-removes without any hashing
+// - Erasion moves last entity into the freed position, iteration order is not preserved
+class EntityRegistry {
+public:
+	EntityRegistry() = default;
+
+	ntt::EntityHandle insert(std::unique_ptr<ntt::Entity> &&entity); // assigns 'entity->handle', groups are deduced from modules and type
+	std::unique_ptr<ntt::Entity> extract(ntt::EntityHandle handle); // removes entity without destroying it
+	void erase(ntt::EntityHandle handle);
+
+	ntt::Entity* get(ntt::EntityHandle handle) const; // returns nullptr if handle is stale
+	bool in_group(ntt::EntityHandle handle, EntityGroup group) const;
+
+	const std::vector<ntt::Entity*>& group(EntityGroup group) const;
+
+	// Flags emited when corresponding entity gets erased
+	void set_on_death_emit(ntt::EntityHandle handle, const Flag &flag);
+	const Flag* get_on_death_emit(ntt::EntityHandle handle) const; // returns nullptr if entity doesn't emit anything
+
+	// Dense iteration
+	size_t size() const;
+	ntt::Entity* operator[](size_t index) const;
+
+	std::vector<std::unique_ptr<ntt::Entity>>::iterator begin();
+	std::vector<std::unique_ptr<ntt::Entity>>::iterator end();
+	std::vector<std::unique_ptr<ntt::Entity>>::const_iterator begin() const;
+	std::vector<std::unique_ptr<ntt::Entity>>::const_iterator end() const;
+
+private:
+	static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+	struct Slot {
+		std::uint32_t generation = 0;
+		std::uint32_t dense_index = NONE; // 'NONE' if slot is free
+		std::uint32_t next_free = NONE;
+		std::array<std::uint32_t, ENTITY_GROUP_COUNT> group_index; // 'NONE' if entity isn't in the group
+		Flag on_death_emit;
+	};
+
+	std::vector<Slot> slots;
+	std::uint32_t free_head = NONE; // free slots form an intrusive list
+
+	std::vector<std::unique_ptr<ntt::Entity>> dense;
+	std::array<std::vector<ntt::Entity*>, ENTITY_GROUP_COUNT> groups;
+
+	const Slot* _resolve(ntt::EntityHandle handle) const; // returns nullptr if handle is stale
+
+	void _group_add(std::uint32_t slotIndex, EntityGroup group);
+	void _group_remove(std::uint32_t slotIndex, size_t group);
+};
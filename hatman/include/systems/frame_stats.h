@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array> // related type (session histogram)
+#include <cstdint> // fixed-size ints (histogram counters)
+#include <deque> // related type (rolling window)
+#include <ostream> // writing summaries
+
+#include "systems/timer.h" // 'Milliseconds' type
+
+
+
+// # FrameStats #
+// - Keeps frame, update and draw times of the frames that fit into the last 'WINDOW_MS'
+// - Window percentiles are recomputed every 'REFRESH_RATE_MS', so reading them every frame is cheap
+// - Frame counts as a hitch if it took 'HITCH_FACTOR' times longer than the window median and
+//   no less than 'HITCH_MIN_MS', stutter is what players notice, average FPS hides it
+// - Whole session is tracked through a fixed-size histogram, so the exit summary needs no per-frame storage,
+//   session percentiles are precise up to 'HISTOGRAM_RESOLUTION_MS'
+class FrameStats {
+public:
+	static constexpr Milliseconds WINDOW_MS = 5000.;
+	static constexpr Milliseconds REFRESH_RATE_MS = 250.;
+	static constexpr double HITCH_FACTOR = 2.;
+	static constexpr Milliseconds HITCH_MIN_MS = 25.;
+	static constexpr Milliseconds HISTOGRAM_RESOLUTION_MS = 0.1;
+	static constexpr size_t HISTOGRAM_BUCKETS = 2000; // the last bucket also holds all frames over 200 ms
+
+	struct Sample {
+		Milliseconds frame; // real time between frames, not clamped and not affected by timescale
+		Milliseconds update; // time spent in simulation steps
+		Milliseconds draw; // time spent drawing and displaying
+		bool is_hitch;
+	};
+
+	struct Summary {
+		size_t frames = 0;
+		size_t hitches = 0;
+
+		Milliseconds p50 = 0.;
+		Milliseconds p95 = 0.;
+		Milliseconds p99 = 0.;
+		Milliseconds max = 0.;
+
+		Milliseconds avg_update = 0.;
+		Milliseconds avg_draw = 0.;
+	};
+
+	FrameStats();
+
+	void record(Milliseconds frameTime, Milliseconds updateTime, Milliseconds drawTime);
+
+	const Summary& window() const; // stats of the last 'WINDOW_MS', as of the last refresh
+	Summary session() const; // stats of every recorded frame
+
+	const std::deque<Sample>& samples() const; // frames of the window from oldest to newest
+
+	void write_summary(std::ostream &stream) const; // human-readable session stats
+
+private:
+	std::deque<Sample> window_samples;
+	Milliseconds window_time; // sum of frame times in the window
+
+	Summary window_summary;
+	Milliseconds time_since_refresh;
+
+	std::array<std::uint32_t, HISTOGRAM_BUCKETS> session_histogram;
+	Summary session_totals; // only counts, maximum and sums (stored in averages), percentiles are taken from histogram
+
+	void _refresh();
+};
@@ -1,10 +1,20 @@
 #pragma once
 
+#include <cstdint> // fixed-size ints (seed, state checksum)
+#include <future> // level preloading
+
 #include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp> // 'VertexArray' type (frame time graph)
 
 #include "systems/timer.h" // 'Timer' class, 'Milliseconds' type
+#include "systems/frame_stats.h" // 'FrameStats' class
 #include "systems/input.h" // 'Input' class
 #include "systems/level.h" // 'Level' class
+#include "systems/level_cache.h" // 'LevelCache' class
+
+
+class InputRecorder;
+class InputReplay;
 
 
 enum class ExitCode {
@@ -28,6 +38,9 @@ public:
 	static Game* ACCESS;
 
 	ExitCode game_loop(); // called from outside to start the game loop
+	ExitCode run_frames(size_t frameCount);
+		// runs given number of simulation steps without polling the window or drawing, timescale is ignored
+		// used by headless builds, returns early if exit was requested
 
 	bool show_fps_counter;
 	bool toggle_F3;
@@ -37,31 +50,57 @@ public:
 	void request_levelLoadFromSave();
 	void request_levelChange(const std::string &newLevel, const Vector2d newPosition); // changes level to given, version is loaded from save
 	void request_levelReload();
+	void request_levelPreload(const std::string &levelName);
+		// starts loading level map on a worker thread, changing to that level then only has to build it,
+		// repeated requests for the same level are ignored
 
 	void request_goToMainMenu();
 	void request_goToEndingScreen();
 	void request_toggleEscMenu();
 	void request_toggleInventory();
 	void request_toggleF3();
+	void request_toggleProfiler(); // dumps recorded frames once profiler is turned off
 	void request_exitToDesktop();
 	void request_exitToRestart();
+	void request_cameraSnap(); // camera jumps to its position after the current step instead of being interpolated there
 
 	bool paused;
 	double timescale;
 
+	std::uint32_t rng_seed;
+		// every level reseeds the game RNG from this seed and its name,
+		// so runs with the same seed and input produce the same randomness
+	RandomGenerator rng; // bound as generator of 'rand_...()' functions while game exists
+
 	std::unique_ptr<Level> level;
+	LevelCache level_cache; // recently left levels
 
 	Input input;
 
+	InputRecorder* input_recorder = nullptr; // when set, input of every simulation step is recorded
+	InputReplay* input_replay = nullptr;
+		// when set, input of every simulation step is taken from the replay instead of the window,
+		// game exits once replay ends
+
 	Milliseconds _true_time_elapsed;
 		// used by some GUI things that calculate time independent from timescale
 		// mostly here for FPS counter
 
+	FrameStats frame_stats; // frame times of rendered frames, shown in F3 mode and summarized upon exit
+
+	double interpolation_alpha() const;
+		// how far rendering is between the last two simulation steps, in [0, 1)
+
+	std::uint64_t state_checksum() const;
+		// hash of simulation state checked by replays, depends only on simulated values
+		// (no rendering, audio device or wall-clock time), so it's the same in main and headless builds
+
 	void _reset_graphics();
 
 private:
 
 	ExitCode handle_requests(); // exit game if returns false
+	ExitCode simulation_step(Milliseconds stepTime); // handles requests and updates everything by a given timestep
 	void update_everything(Milliseconds elapsedTime); // updates everything
 	void draw_everything(); // draws everything, not const because level can add nullptrs to the tilemap during drawing
 
@@ -71,10 +110,12 @@ private:
 	bool _requested_toggle_esc_menu;
 	bool _requested_toggle_inventory;
 	bool _requested_toggle_F3;
+	bool _requested_toggle_profiler;
 	ExitCode _requested_exit_to_desktop;
 	bool _requested_level_load_from_save;
 
 	bool _requested_level_change;
+	bool _requested_camera_snap;
 
 	bool level_change_is_reload; // true if level change is reload from save
 	std::string level_change_target; // name of the level to change
@@ -84,11 +125,37 @@ private:
 
 	Timer smooth_transition_timer; // waits for fade animations to finish
 
+	// Preloading
+	struct PreloadedLevel {
+		LevelData data;
+		bool loaded; // errors are logged once data is taken on the main thread, logger isn't thread-safe
+	};
+
+	std::string level_preload_name; // empty if nothing is preloaded
+	std::future<PreloadedLevel> level_preload;
+
+	// Fixed timestep
+	Milliseconds time_accumulator; // simulation time that wasn't yet consumed by steps
+	double step_alpha;
+	Vector2d camera_position_previous; // camera is interpolated along with entities
+
 	void _level_swapToTarget();
 	void _level_loadFromSave();
+	void _level_reseedRNG(const std::string &levelName); // called before level construction
+	LevelData _level_takeData(const std::string &levelName); // takes preloaded data if present, loads it otherwise
+	std::unique_ptr<Level> _level_build(const std::string &levelName, std::unique_ptr<ntt::Entity> &&player);
+		// builds level from cache if present, from preloaded or loaded data otherwise
 
 	// Testing (F3 toggle)
 	void _drawHitboxes(); // shows an outline of all hitboxes and tule actionboxes
 	///void _drawLevelobjects() const; // shows an outline of all objects on a level
 	void _drawInfo() const; // shows content of EmitStorage
+	void _drawFrameStats(); // shows frame time graph, percentiles, hitches and object counts
+
+	sf::VertexArray frame_stats_graph; // kept alive till the end of the frame, batches only store a pointer
+
+	// Profiling (F4 toggle)
+	void _dumpProfile() const; // writes recorded frames as Chrome trace
+
+	void _writeFrameStats() const; // writes session frame time summary, called upon destruction
 };
\ No newline at end of file
@@ -2,11 +2,29 @@
 
 #include <SFML/Graphics.hpp> /// Perhaps system is enough?
 
-#include <unordered_map> // related type
+#include <bitset> // related type
 #include "utility/geometry.h" // Vector2d
 
 
 
+// # InputState #
+// - Plain state of keyboard and mouse during a single simulation step
+// - Kept separate from 'Input' so it can be copied, recorded and replayed
+struct InputState {
+	std::bitset<sf::Keyboard::KeyCount> keys_pressed;
+	std::bitset<sf::Keyboard::KeyCount> keys_held;
+	std::bitset<sf::Keyboard::KeyCount> keys_released;
+
+	std::bitset<sf::Mouse::ButtonCount> buttons_pressed;
+	std::bitset<sf::Mouse::ButtonCount> buttons_held;
+	std::bitset<sf::Mouse::ButtonCount> buttons_released;
+
+	Vector2d mouse_position; // mouse position in natural 640x360 scale
+		// (0, 0) if mouse is outside the window
+};
+
+
+
 // # Input #
 // - Holds all pressed/released/held keys for a single frame
 // - Basically a wrapper for ugly SDL event system
@@ -37,19 +55,10 @@ public:
 	double mouseX() const; 
 	double mouseY() const;
 
-private:
-	// Note that [] of nonexistant key initializes pair <key, FALSE> in the map (standard C++14)
-
-	// Keyboard
-	std::unordered_map<sf::Keyboard::Key, bool> keys_pressed;
-	std::unordered_map<sf::Keyboard::Key, bool> keys_released;
-	std::unordered_map<sf::Keyboard::Key, bool> keys_held;
-
-	// Mouse
-	std::unordered_map<sf::Mouse::Button, bool> buttons_pressed;
-	std::unordered_map<sf::Mouse::Button, bool> buttons_released;
-	std::unordered_map<sf::Mouse::Button, bool> buttons_held;
+	// State (used by input recording/replay)
+	const InputState& get_state() const;
+	void set_state(const InputState &state);
 
-	Vector2d mouse_position; // mouse position in natural 640x360 scale
-		// (0, 0) if mouse is outside the window
+private:
+	InputState state; // keys outside of SFML range ('sf::Keyboard::Unknown') are ignored
 };
\ No newline at end of file
@@ -1,11 +1,11 @@
 #pragma once
 
-#include <unordered_map> // entities sorted by type are stored in a map
-#include <unordered_set> // used to create access groups for entities
-#include "thirdparty/nlohmann.hpp" // parsing from JSON, 'nlohmann::json' type
+#include <cstdint> // 'uint16_t' (tile grid)
+#include <limits> // empty tile marker
 
 #include "utility/geometry.h" // geometry types
 #include "objects/tile_base.h" // 'Tile' base class
+#include "graphics/tile_mesh.h" // 'TileMesh' class (baked tile layers)
 #include "entity/type_m.h" // 'Entity' base class, 'Creature' class
 #include "objects/script.h"
 ///#include "script_base.h" // 'Script' base class
@@ -13,22 +13,47 @@
 #include "utility/collection.hpp" // 'Collection' class
 #include "systems/timer.h" // 'Milliseconds' type
 #include "systems/flags.h"
+#include "systems/particles.h" // 'ParticleSystem' class
+#include "systems/spatial_grid.h" // 'SpatialGrid' class
+#include "systems/tile_collision_grid.h" // 'TileCollisionGrid' class
+#include "systems/entity_registry.h" // 'EntityRegistry' class
+#include "systems/level_data.h" // 'LevelData' struct
+#include "utility/globalconsts.hpp" // natural consts (tile size)
 
 
 
 // # Level #
 // - Holds tiles, entities and scripts present on a map
-// - Holds stores copies of tilesets that are used in given level
+// - Refers to tilesets that are used in given level, tileset data is shared through 'TilesetStorage'
 // - Holds level background
 // - Handles updating and drawing of all aforementioned objects
+// - Entity physics is updated on the 'utl::parallel' thread pool before the serial logic pass,
+//   so 'SolidRectangle::update()' must not touch anything outside of its own entity
 class Level {
 public:
 	Level() {};
 
 	Level(const std::string &name);
+	Level(const std::string &name, LevelData data);
 	Level(const std::string &name, std::unique_ptr<ntt::Entity> &&player);
+	Level(const std::string &name, LevelData data, std::unique_ptr<ntt::Entity> &&player);
 		// also inits player upon construction
 
+	// Caching
+	// - tile grid, tile meshes and collision grid only depend on level data, once level is left they are
+	//   moved into 'LevelCache' together with the data, everything else is rebuilt when level is entered again,
+	//   so a level built from cache is identical to a freshly built one
+	struct Geometry;
+
+	Level(const std::string &name, LevelData data, Geometry &&geometry, std::unique_ptr<ntt::Entity> &&player);
+		// skips tile baking, geometry should come from a level built from the same data
+
+	void _release(LevelData &data, Geometry &geometry); // !!! after calling, level object is no longer valid !!!
+
+	static LevelData loadData(const std::string &name); // logs an error if level couldn't be loaded
+	static bool loadData(const std::string &name, LevelData &data);
+		// loads level map from disk, doesn't log or touch any storages so it's safe to call from a worker thread
+
 	void update(Milliseconds elapsedTime);
 	void draw();
 
@@ -40,84 +65,114 @@ public:
 	int getSizeY() const;
 	const std::string& getName() const;
 
-	Tile* getTile(const Vector2 &index); // assumes index isn't out-of-bounds, otherwise you explode
-	Tile* getTile(int indexX, int indexY);
+	// Tiles
+	bool hasTile(int indexX, int indexY) const; // checks logic layer, assumes index isn't out-of-bounds, otherwise you explode
+	size_t getTileCount() const; // non-empty cells of logic layer
+
+	TileCollisionGrid collision_grid; // hitboxes of logic layer tiles, use it for all tile collision checks
+
+	const std::vector<std::unique_ptr<Tile>>& getTileObjects() const; // animated and interactive tiles of logic layer
 
 	// Entities
-	// Container that actually owns all entites
-	std::vector<std::unique_ptr<ntt::Entity>> entities;
+	EntityRegistry entities; // owns all entities, allows accessing them in a 'sorted by properties/type' fashion through groups
+		// static_cast/dynamic_cast if access to type-specific stuff is needed
 
-	// Containers that allow accessing entities in a 'sorted by properties/type' fashion
-	std::unordered_set<ntt::Entity*> entities_solid;
-	std::unordered_set<ntt::Entity*> entities_killable; // 'killable' == 'has .solid' + 'has .health'
+	SpatialGrid entities_grid; // broadphase over 'EntityGroup::KILLABLE', use it instead of iterating the group
 
-	std::unordered_map<ntt::TypeId, std::unordered_set<ntt::Entity*>> entities_type; // dynamic_cast if access to type-specific stuff is needed
+	size_t delayed_erase_count = 0;
+		// entities erased after a delay (waiting for their sounds or death animations) since construction,
+		// such erases depend on sound timing, so replays check this count to make sure it's build-independent
 	
 	ntt::player::Player* player;
 
 	void spawn(std::unique_ptr<ntt::Entity> &&entity); // adds entity to spawn_queue
 
+	ParticleSystem particles; // purely visual particles live outside of the entity system
+
 	std::unique_ptr<ntt::Entity> _extractPlayer(); // !!! after calling, level object is no longer valid !!!
+
+	// Update stages
+	// - called by 'update()', exposed so 'hatman_bench' can time them separately
+	void _insertFromSpawnQueue(); // also clears the queue
+	void _eraseMarkedEntities(); // also emits on-death flags of erased entities
 	
 private:
 	std::vector<std::unique_ptr<ntt::Entity>> _spawn_queue;
-	void _insertFromSpawnQueue();
 	void _insertNewEntity(std::unique_ptr<ntt::Entity> &&entity);
 
-	void _eraseMarkedEntities();
-	std::unordered_map<ntt::Entity*, Flag> _on_death_emits;
-		// flags that are emited when corresponding entity gets erased
+	std::vector<ntt::Entity*> _update_list; // entities in update range, reused between steps
+	std::vector<ntt::Entity*> _physics_list; // subset of the above with active physics
+	void _updatePhysics(Milliseconds elapsedTime);
 
 	// Tiles
-	std::vector<std::unique_ptr<Tile>> tiles_backlayer;
-	std::vector<std::unique_ptr<Tile>> tiles; // actually handles logic
-	std::vector<std::unique_ptr<Tile>> tiles_midlayer;
-	std::vector<std::unique_ptr<Tile>> tiles_frontlayer;
-		// - all layer types except 'tiles' are purely decorative and have physics/logic turned off
-		// - rendering order is as follows: [backlayer]->[midlayer]->[layer]->[entities]->[frontlayer]
+	// - only logic layer is stored per cell, as a grid of indices into 'tile_kinds'
+	// - all other layers are purely decorative, they have physics/logic turned off and only exist as meshes
+	// - rendering order is as follows: [backlayer]->[layer]->[entities]->[frontlayer]
+	// - [midlayer] is parsed but never drawn
+	struct TileKind {
+		const Tileset* tileset;
+		int id;
+		const TileHitbox* hitbox; // shared tileset data in tile-local coordinates, nullptr if tile has no hitbox
+	};
+
+	static constexpr std::uint16_t NO_TILE = std::numeric_limits<std::uint16_t>::max();
+
+	std::vector<TileKind> tile_kinds; // every distinct tile present on the logic layer
+	std::vector<std::uint16_t> tiles; // 'NO_TILE' for empty cells
+	size_t tile_count = 0;
+
+	std::vector<std::unique_ptr<Tile>> tile_objects; // logic layer tiles that need to be updated
+
+	TileMesh mesh_backlayer;
+	TileMesh mesh_tiles;
+	TileMesh mesh_frontlayer;
+		// layers are drawn through meshes baked upon parsing, 'Tile::draw()' is not used by the level
 	
 	size_t _getTile1DIndex(const Vector2 &index) const;
 	size_t _getTile1DIndex(int indexX, int indexY) const;
 
-	// Parsing
-	void parseFromJSON(const std::string &filePath);
-
-	// Tile parsing
-	void parse_tilelayer(const nlohmann::json &tilelayer_node); // does all tilelayer parsing
+	// Construction
+	LevelData data; // kept so level can be cached once it's left
 
-	// Entity parsing
-	void parse_objectgroup(const nlohmann::json &objectgroup_node); // redirects to parse_entity() or parse_script()
-	void parse_objectgroup_entity(const nlohmann::json &objectgroup_node);
+	void _buildGeometry(); // bakes tile layers described by level data
+	void _buildObjects(); // creates tile objects, entities and scripts described by level data
 
-	// Scripts parsing
-	void parse_objectgroup_script_levelChange(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_levelSwitch(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_portal(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_hint(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_checkpoint(const nlohmann::json &objectgroup_node);
-	/*void parse_objectgroup_script_PlayerInArea(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_AND(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_OR(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_XOR(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_NAND(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_NOR(const nlohmann::json &objectgroup_node);
-	void parse_objectgroup_script_XNOR(const nlohmann::json &objectgroup_node);*/
-
-
-	void add_Tile(const Tileset &tileset, int id, const Vector2 position, const std::string &layerPrefix);
-		// adds tile to the level with respect to its interactions and etc
-		// backlayer tiles are only drawn, other logic is ignored
+	void add_Tile(const Tileset &tileset, int id, const Vector2 position, LevelData::TileLayer layer);
+		// bakes tile into the mesh of its layer, logic layer tiles are also added to the tile grid
+	void add_TileObject(const Tileset &tileset, int id, const Vector2 position);
+		// creates an object for a logic layer tile if it's animated or interactive, decorative tiles have none
 
 	ntt::Entity* add_Entity(const std::string &type, const std::string &name, Vector2d position);
 		// returns ptr to created entity
 		// no need for 'add_Item()' as items can't exist outside of inventories
 		// no need for 'add_Script()' as scripts can't be standardized under the same constructor parameters
 
-	std::vector<Tileset> tilesets; // all tilesets of a current level, tilesets are ordered by firstgid
+	std::vector<const Tileset*> tilesets; // all tilesets of a current level, indexed same as in level data
 
 	sf::Sprite background_sprite;
+	std::string music;
 
 	Vector2 map_size;
 
 	std::string levelName;
+};
+
+
+
+// # Level::Geometry #
+// - Everything 'Level' builds out of tile layers, see 'Level' caching
+struct Level::Geometry {
+	std::vector<const Tileset*> tilesets;
+
+	std::vector<TileKind> tile_kinds;
+	std::vector<std::uint16_t> tiles;
+	size_t tile_count = 0;
+
+	TileCollisionGrid collision_grid;
+
+	TileMesh mesh_backlayer;
+	TileMesh mesh_tiles; // animated tiles are unbound
+	TileMesh mesh_frontlayer;
+
+	size_t memory() const; // approximate
 };
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <list> // related type
+#include <memory> // 'unique_ptr' type
+#include <string> // related type
+
+#include "systems/level.h" // 'Level' class, 'Level::Geometry' struct
+#include "systems/level_data.h" // 'LevelData' struct
+
+
+
+// # LevelCache #
+// - Keeps data and geometry (tile grid, baked tile meshes, collision grid) of recently left levels,
+//   so going back to them skips disk access and tile baking
+// - Only the pristine result of parsing is kept, tile objects, entities and scripts are rebuilt
+//   on every 'take()', so a level taken from cache is identical to a freshly built one
+// - Flags only decide which entities and scripts get built, cached part doesn't depend on them,
+//   so levels are keyed by name alone
+// - Bounded by approximate memory, least recently used levels are evicted first
+class LevelCache {
+public:
+	LevelCache(size_t memoryBudget);
+
+	void store(std::unique_ptr<Level> &&level); // level should have player extracted already, the rest of it is destroyed
+	std::unique_ptr<Level> take(const std::string &name, std::unique_ptr<ntt::Entity> &&player);
+		// builds level from cached data and geometry, returns nullptr if level isn't cached (player is left untouched)
+	bool contains(const std::string &name) const; // true if 'take()' would succeed
+
+	void clear();
+
+	size_t size() const;
+	size_t memory() const;
+
+private:
+	struct Entry {
+		std::string name;
+		LevelData data;
+		Level::Geometry geometry;
+		size_t memory;
+	};
+
+	std::list<Entry> entries; // most recently used first, there are only a few levels so search is linear
+
+	size_t memory_used;
+	size_t memory_budget;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array> // related type
+#include <cstdint> // fixed-size ints
+#include <limits> // empty tile marker
+#include <string> // related type
+#include <vector> // related type
+
+#include "utility/vector2.hpp" // 'Vector2', 'Vector2d' types
+
+
+
+// # LevelData #
+// - Plain description of a level map, contains no runtime objects
+// - Can be parsed from Tiled JSON or loaded from a compiled binary ('.hlvl') produced by 'hatman_levelc'
+// - Tile gids are pre-resolved into tileset indices and local tile ids, so constructing
+//   a level doesn't search tilesets or compare layer names per tile
+// - Flags are not checked here since they are a runtime state, 'Level' filters entities and scripts
+//   by their 'requires_flag' during construction
+struct LevelData {
+	enum class TileLayer : std::uint8_t {
+		BACKLAYER,
+		LAYER,
+		MIDLAYER,
+		FRONTLAYER
+	};
+
+	static constexpr size_t TILE_LAYER_COUNT = 4;
+
+	enum class ScriptType : std::uint8_t {
+		LEVEL_CHANGE,
+		LEVEL_SWITCH,
+		PORTAL,
+		HINT,
+		CHECKPOINT
+	};
+
+	static constexpr std::uint16_t NO_TILESET = std::numeric_limits<std::uint16_t>::max();
+
+	struct TilesetRef {
+		std::string name; // file name inside 'content/tilesets/'
+		int first_gid;
+	};
+
+	struct TileRef {
+		std::uint16_t tileset = NO_TILESET; // 'NO_TILESET' if cell is empty
+		std::uint16_t id = 0; // id inside the tileset
+	};
+
+	struct EntityRecord {
+		TileRef tile; // entities are placed as tile objects, spawn data is stored in the tileset
+		Vector2d position; // Tiled object position (bottom-left corner)
+		std::string requires_flag;
+		std::string emits_flag;
+	};
+
+	struct ScriptRecord {
+		ScriptType type;
+		int x, y, width, height; // hitbox
+
+		std::string goes_to_level; // level change/switch
+		Vector2 goes_to_pos; // level change/switch, portal
+
+		std::string text; // hint
+		Vector2d text_center; // hint
+		Vector2d text_size; // hint
+
+		std::string requires_flag; // checkpoint
+		std::string emits_flag; // checkpoint
+	};
+
+	std::string background;
+	std::string music;
+
+	Vector2 size; // in tiles
+
+	std::vector<TilesetRef> tilesets; // ordered by 'first_gid'
+
+	std::array<std::vector<TileRef>, TILE_LAYER_COUNT> layers;
+		// row-major 'size.x * size.y' arrays, layers that are not present in the map are left empty
+
+	std::vector<EntityRecord> entities;
+	std::vector<ScriptRecord> scripts;
+
+	bool load(const std::string &jsonPath);
+		// loads compiled binary next to the JSON if it's present and up to date, parses JSON otherwise
+	bool parseFromJSON(const std::string &filePath); // returns false if file can't be opened or map size is invalid
+
+	bool loadFromBinary(const std::string &filePath);
+		// reads the whole file in one go and decodes it from memory,
+		// returns false if file is missing, has a different format version or is malformed
+	bool saveToBinary(const std::string &filePath) const;
+
+	static std::string binaryPath(const std::string &jsonPath); // 'name.json' -> 'name.hlvl'
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <vector> // related type
+
+#include "utility/geometry.h" // geometry types
+#include "utility/color.hpp" // 'RGBColor' type
+#include "systems/timer.h" // 'Milliseconds' type
+#include "graphics/texture_atlas.h" // 'TextureRegion' type
+
+
+
+// # ParticleSystem #
+// - Pool of simple physical particles (small squares that fall, slide and collide with tiles)
+// - Particles are stored as a struct-of-arrays with fixed capacity, emission and death
+//   don't allocate, dead particles are swap-removed
+// - Tile collision is simplified: particles are treated as tiny rects resolved per axis
+//   against neighbouring tiles, no entity interaction
+// - All particles are drawn as a single vertex array, interpolated between the last two steps same as entities
+class ParticleSystem {
+public:
+	ParticleSystem();
+
+	void emit(const Vector2d &position, const Vector2d &speed, const RGBColor &color, Milliseconds lifetime);
+		// particle is dropped if the pool is full
+
+	void update(Milliseconds elapsedTime);
+	void draw();
+
+	size_t count() const;
+	void clear();
+
+private:
+	// Struct-of-arrays
+	std::vector<double> position_x;
+	std::vector<double> position_y;
+	std::vector<double> previous_x; // positions before the last step (interpolation)
+	std::vector<double> previous_y;
+	std::vector<double> speed_x;
+	std::vector<double> speed_y;
+	std::vector<Milliseconds> lifetime_left;
+	std::vector<sf::Color> color;
+	std::vector<bool> grounded;
+
+	size_t particle_count;
+
+	TextureRegion texture_region;
+	sf::VertexArray vertices; // rebuilt upon drawing, kept as a member since it's only rendered upon display
+
+	void _kill(size_t index);
+	void _resolve_TileCollisions(size_t index, double movementX, double movementY);
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono> // measuring zone time
+#include <cstdint> // fixed-size ints (timestamps)
+#include <string> // related type
+#include <vector> // related type
+
+
+
+// # FrameProfiler #
+// - Records named zones of the last 'FRAME_CAPACITY' frames into a ring buffer
+// - Disabled by default, while disabled zones cost a single branch
+// - Recorded frames can be dumped as Chrome trace JSON (open in 'chrome://tracing' or Perfetto)
+// - Only the main thread is profiled, zones must not be opened from workers
+// - Zone names must be string literals, only pointers are stored
+class FrameProfiler {
+public:
+	FrameProfiler(const FrameProfiler& other) = delete;
+	void operator = (const FrameProfiler& other) = delete;
+
+	static FrameProfiler& get();
+
+	static constexpr size_t FRAME_CAPACITY = 600;
+
+	void set_enabled(bool enabled); // enabling starts a fresh recording
+	bool is_enabled() const;
+
+	void begin_frame(); // takes the oldest frame slot of the ring buffer
+	void end_frame();
+
+	bool begin_zone(const char* name); // returns false if zone wasn't recorded (disabled or outside of a frame)
+	void end_zone();
+
+	bool dump_chrome_trace(const std::string &filePath) const; // writes frames from oldest to newest
+
+	// # FrameProfiler::Zone #
+	// - Records a zone from construction till destruction
+	class Zone {
+	public:
+		Zone(const char* name);
+		~Zone();
+
+	private:
+		bool active; // only recorded zones are closed
+	};
+
+private:
+	FrameProfiler();
+
+	using clock = std::chrono::steady_clock;
+
+	struct Event {
+		const char* name;
+		std::int64_t begin; // in ns since profiler creation
+		std::int64_t end;
+		std::uint32_t depth;
+	};
+
+	struct Frame {
+		std::int64_t begin;
+		std::int64_t end;
+		std::vector<Event> events;
+	};
+
+	bool enabled;
+	bool frame_open;
+
+	clock::time_point origin;
+
+	std::vector<Frame> frames;
+	size_t frame_count; // recorded frames, never exceeds capacity
+	size_t current_frame; // index of the newest frame
+
+	std::vector<size_t> zone_stack; // indices of open zones in the current frame
+
+	std::int64_t _now() const;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint> // fixed-size ints (binary format)
+#include <fstream> // related type
+#include <string> // related type
+
+#include "systems/input.h" // 'InputState' type
+#include "systems/timer.h" // 'Milliseconds' type
+
+
+
+// Replay format
+// - Header: magic "HRPL", format version, RNG seed, snapshot of the save file at the moment recording started
+// - Followed by one record per simulation step: a byte mask of 'InputState' components that changed
+//   since the previous step, followed by those components (most steps take a single byte)
+// - Every 'CHECKSUM_PERIOD'-th record is followed by a checksum of simulation state after that step
+//   ('Game::state_checksum()'), replay compares it with its own state and reports the first step where runs diverged,
+//   this is how recordings of the main build are checked against headless replays
+// - Values are stored in native byte order, replays are meant to be replayed on the same kind of machine
+// - Replays always start from a fresh launch, game restarts are not recorded
+namespace replay_format {
+	constexpr size_t CHECKSUM_PERIOD = 120; // once per second of game time
+}
+
+
+
+// # InputRecorder #
+// - Writes input of every simulation step to a replay file
+class InputRecorder {
+public:
+	InputRecorder(const std::string &filePath, std::uint32_t seed, const std::string &saveFilePath);
+		// save file is snapshotted upon construction
+
+	bool is_open() const;
+
+	void write_step(const InputState &state, Milliseconds elapsedTime);
+
+	bool checksum_due() const; // true if the last written step must be followed by a checksum
+	void write_checksum(std::uint64_t checksum);
+
+	size_t step_count() const;
+
+private:
+	std::ofstream file;
+
+	InputState previous_state;
+	Milliseconds previous_elapsed_time;
+
+	size_t steps;
+};
+
+
+
+// # InputReplay #
+// - Reads replay file and reproduces input of every recorded simulation step
+class InputReplay {
+public:
+	InputReplay(const std::string &filePath);
+
+	bool is_open() const; // false if file couldn't be opened or header is invalid
+
+	std::uint32_t seed() const;
+	void write_save(const std::string &saveFilePath) const; // restores save snapshot to a given file
+
+	bool read_step(InputState &state, Milliseconds &elapsedTime);
+		// returns false once replay has ended, arguments are left untouched in that case
+	bool finished() const;
+
+	bool checksum_due() const; // true if the last read step is followed by a checksum
+	bool verify_checksum(std::uint64_t checksum);
+		// compares checksum of the replayed state with the recorded one, returns false on mismatch
+
+	size_t step_count() const;
+	size_t checksums_verified() const;
+	bool diverged() const;
+	size_t first_divergent_step() const; // only valid if replay diverged, steps are counted from 1
+
+private:
+	std::ifstream file;
+
+	std::uint32_t rng_seed;
+	bool save_present;
+	std::string save_contents;
+
+	InputState current_state;
+	Milliseconds current_elapsed_time;
+
+	bool header_valid;
+	bool is_finished;
+
+	size_t steps;
+	size_t checksums;
+	size_t divergent_step; // 0 if replay didn't diverge
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm> // 'max()'
+#include <vector> // related type
+
+#include "utility/geometry.h" // geometry types
+#include "utility/globalconsts.hpp" // tile size
+
+
+
+namespace ntt {
+	class Entity;
+}
+
+
+
+// # SpatialGrid #
+// - Uniform grid broadphase for entity-vs-entity queries
+// - Rebuilt by 'Level' once per update after the physics phase, entities are binned by their hitboxes into
+//   every cell they overlap, cells are stored contiguously (counting sort) so rebuild doesn't allocate
+//   once capacity is reached
+// - Queries test exact current hitboxes, cells are padded by a margin so small changes made
+//   since the rebuild are still found, entities moved further (teleports) must be 'relocate()'ed
+// - Queries visit results through a callback and don't allocate, entities spanning several cells are reported only once
+class SpatialGrid {
+public:
+	static constexpr double CELL_SIZE = 2. * natural::TILE_SIZE; // most entities fit into a single cell
+	static constexpr double QUERY_MARGIN = natural::TILE_SIZE; // covers hitbox changes between rebuilds
+
+	SpatialGrid() = default;
+
+	void init(const Vector2 &mapSize); // map size in tiles, entities outside of the map are binned into border cells
+
+	void rebuild(const std::vector<ntt::Entity*> &entities); // entities must have '.solid'
+
+	void relocate(const ntt::Entity* entity);
+		// entity moved further than the margin since the rebuild, it's checked by every query until the next rebuild,
+		// does nothing for entities that aren't in the grid
+
+	template<typename Callback>
+	void for_each_in_rect(const dRect &area, Callback &&callback) const;
+		// calls 'callback(ntt::Entity*)' for entities with hitboxes overlapping the area
+	template<typename Callback>
+	void for_each_in_radius(const Vector2d &center, double radius, Callback &&callback) const;
+		// calls 'callback(ntt::Entity*)' for entities with hitboxes intersecting the circle
+
+private:
+	struct Entry {
+		ntt::Entity* entity;
+		int cellLeft;
+		int cellTop;
+		int cellRight;
+		int cellBottom;
+		bool relocated; // cells are stale, entry is checked through 'relocated' instead
+	};
+
+	int size_x = 0;
+	int size_y = 0;
+
+	std::vector<Entry> entries;
+	std::vector<size_t> cell_begin; // entries of cell 'i' are 'cell_entries[cell_begin[i]]'...'cell_entries[cell_begin[i + 1] - 1]'
+	std::vector<size_t> cell_entries; // indices into 'entries'
+	std::vector<size_t> relocated; // indices into 'entries', usually empty
+
+	int _cellX(double x) const;
+	int _cellY(double y) const;
+	size_t _cellIndex(int cellX, int cellY) const;
+
+	static bool _overlaps_rect(const ntt::Entity* entity, const dRect &area);
+	static bool _overlaps_circle(const ntt::Entity* entity, const Vector2d &center, double radius);
+
+	template<typename Callback>
+	void _for_each_candidate(const dRect &area, Callback &&callback) const;
+};
+
+
+
+template<typename Callback>
+void SpatialGrid::for_each_in_rect(const dRect &area, Callback &&callback) const {
+	this->_for_each_candidate(area, [&](ntt::Entity* entity) {
+		if (_overlaps_rect(entity, area)) callback(entity);
+	});
+}
+
+template<typename Callback>
+void SpatialGrid::for_each_in_radius(const Vector2d &center, double radius, Callback &&callback) const {
+	const dRect area(center, Vector2d(2. * radius, 2. * radius), true);
+
+	this->_for_each_candidate(area, [&](ntt::Entity* entity) {
+		if (_overlaps_circle(entity, center, radius)) callback(entity);
+	});
+}
+
+template<typename Callback>
+void SpatialGrid::_for_each_candidate(const dRect &area, Callback &&callback) const {
+	if (this->entries.empty()) return;
+
+	const int leftBound = this->_cellX(area.getLeft() - QUERY_MARGIN);
+	const int rightBound = this->_cellX(area.getRight() + QUERY_MARGIN);
+	const int upperBound = this->_cellY(area.getTop() - QUERY_MARGIN);
+	const int lowerBound = this->_cellY(area.getBottom() + QUERY_MARGIN);
+
+	for (int Y = upperBound; Y <= lowerBound; ++Y)
+		for (int X = leftBound; X <= rightBound; ++X) {
+			const size_t cellIndex = this->_cellIndex(X, Y);
+
+			for (size_t k = this->cell_begin[cellIndex]; k < this->cell_begin[cellIndex + 1]; ++k) {
+				const auto &entry = this->entries[this->cell_entries[k]];
+
+				if (entry.relocated) continue;
+
+				// Entity that spans several cells is only reported from the first cell shared with the query
+				if (X != std::max(entry.cellLeft, leftBound) || Y != std::max(entry.cellTop, upperBound)) continue;
+
+				callback(entry.entity);
+			}
+		}
+
+	for (const auto index : this->relocated) callback(this->entries[index].entity);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint> // fixed-size ints (cell masks, offsets)
+#include <functional> // 'function' type (cell hitbox provider)
+#include <vector> // related type
+
+#include "objects/tile_base.h" // 'TileHitbox', 'TileHitboxRect' types
+#include "utility/geometry.h" // geometry types
+#include "utility/globalconsts.hpp" // natural consts (tile size)
+
+
+
+// # TileCollisionGrid #
+// - Flat collision data of the logic tile layer, built by 'Level' upon construction
+// - Every cell has a mask that tells if it's empty, fully solid or has solid/platform rects,
+//   so most cells are rejected or resolved without touching rect storage
+// - Rects of partial hitboxes are packed contiguously in map coordinates, rects of cell 'i'
+//   are 'rects[cell_begin[i]]'...'rects[cell_begin[i + 1] - 1]'
+// - Fully solid cells don't store rects, their rect is the cell itself
+class TileCollisionGrid {
+public:
+	enum CellMask : std::uint8_t {
+		EMPTY = 0,
+		SOLID = 1 << 0, // has non-platform rects
+		PLATFORM = 1 << 1, // has platform rects
+		FULL = 1 << 2 // covered by a single non-platform rect, always set together with 'SOLID'
+	};
+
+	TileCollisionGrid() = default;
+
+	void build(const Vector2 &mapSize, const std::function<const TileHitbox*(int, int)> &getHitbox);
+		// 'getHitbox(X, Y)' returns hitbox of a tile in tile-local coordinates, nullptr for cells with no hitbox
+
+	// Queries (assume index isn't out-of-bounds)
+	std::uint8_t mask(int indexX, int indexY) const;
+
+	template<typename Callback>
+	void for_each_rect(int indexX, int indexY, Callback &&callback) const;
+		// calls 'callback(const TileHitboxRect&)' for every rect of a cell
+	template<typename Callback>
+	void for_each_solid_rect(int indexX, int indexY, Callback &&callback) const;
+		// same as above, but skips platforms
+
+	size_t memory() const; // bytes used by cells and rects
+
+private:
+	int size_y = 0;
+
+	std::vector<std::uint8_t> masks;
+	std::vector<std::uint32_t> cell_begin;
+	std::vector<TileHitboxRect> rects;
+
+	size_t _cellIndex(int indexX, int indexY) const;
+
+	static TileHitboxRect _fullRect(int indexX, int indexY);
+};
+
+
+
+inline std::uint8_t TileCollisionGrid::mask(int indexX, int indexY) const {
+	return this->masks[this->_cellIndex(indexX, indexY)];
+}
+
+template<typename Callback>
+void TileCollisionGrid::for_each_rect(int indexX, int indexY, Callback &&callback) const {
+	const size_t cell = this->_cellIndex(indexX, indexY);
+	const std::uint8_t cellMask = this->masks[cell];
+
+	if (cellMask == EMPTY) return;
+
+	if (cellMask & FULL) {
+		callback(static_cast<const TileHitboxRect&>(_fullRect(indexX, indexY)));
+		return;
+	}
+
+	for (std::uint32_t i = this->cell_begin[cell]; i < this->cell_begin[cell + 1]; ++i) callback(this->rects[i]);
+}
+
+template<typename Callback>
+void TileCollisionGrid::for_each_solid_rect(int indexX, int indexY, Callback &&callback) const {
+	const size_t cell = this->_cellIndex(indexX, indexY);
+	const std::uint8_t cellMask = this->masks[cell];
+
+	if (!(cellMask & SOLID)) return;
+
+	if (cellMask & FULL) {
+		callback(static_cast<const TileHitboxRect&>(_fullRect(indexX, indexY)));
+		return;
+	}
+
+	for (std::uint32_t i = this->cell_begin[cell]; i < this->cell_begin[cell + 1]; ++i)
+		if (!this->rects[i].is_platform) callback(this->rects[i]);
+}
+
+inline size_t TileCollisionGrid::_cellIndex(int indexX, int indexY) const {
+	return static_cast<size_t>(indexX) * this->size_y + indexY; // same layout as level tiles
+}
+
+inline TileHitboxRect TileCollisionGrid::_fullRect(int indexX, int indexY) {
+	return { dRect(indexX * natural::TILE_SIZE, indexY * natural::TILE_SIZE, natural::TILE_SIZE, natural::TILE_SIZE), false };
+}
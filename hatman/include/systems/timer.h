@@ -1,6 +1,7 @@
 #pragma once
 
-#include <unordered_set> // related type ('TimerController' storage)
+#include <cstddef> // 'size_t' type
+#include <vector> // related type ('TimerController' storage)
 #include <limits> // infinity
 
 
@@ -17,13 +18,16 @@ constexpr inline double ms_to_sec(double value) { return value * 0.001; } // ret
 
 // # Timer #
 // - Can be set to a given duration
+// - Running timer is scheduled in 'TimerController', idle timers don't cost anything per frame
+// - Copies of a running timer are scheduled independently
 class Timer {
 public:
 	Timer();
 
-	~Timer();
+	Timer(const Timer &other);
+	Timer& operator=(const Timer &other);
 
-	void update(Milliseconds elapsedTime);
+	~Timer();
 
 	void start(Milliseconds duration);
 	void stop(); // finished the timer instantly
@@ -37,9 +41,16 @@ public:
 	double elapsedPercentage() const; // == .elapsed() / .duration()
 
 private:
+	friend class TimerController;
+
 	Milliseconds timer_duration;
-	Milliseconds time_elapsed;
+	Milliseconds time_elapsed; // only valid once finished, running timers compute it from the controller clock
+	Milliseconds start_time;
 	bool is_finished;
+
+	size_t heap_index; // position in 'TimerController' heap, intrusive so scheduling doesn't allocate per timer
+
+	Milliseconds _deadline() const;
 };
 
 
@@ -48,6 +59,8 @@ private:
 // - Can be accessed wherever #include'ed through static 'READ' and 'ACCESS' fields
 // - Only one instance at a time should exits (creation of new instances however is not controlled in any way)
 // - Handles updating of all existing timers
+// - Keeps a global clock and a min-heap of running timers ordered by deadline,
+//   per frame cost only depends on the number of timers that actually finish
 class TimerController {
 public:
 	TimerController();
@@ -57,8 +70,19 @@ public:
 
 	void update(Milliseconds elapsedTime);
 
+	Milliseconds now() const; // total time passed through 'update()'
+	size_t running_count() const;
+
 private:
 	friend class ::Timer;
 
-	std::unordered_set<Timer*> timers;
+	Milliseconds clock;
+	std::vector<Timer*> heap;
+
+	void _schedule(Timer* timer); // reschedules timer if it's already in the heap
+	void _unschedule(Timer* timer);
+
+	void _sift_up(size_t index);
+	void _sift_down(size_t index);
+	void _heap_swap(size_t index1, size_t index2);
 };
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint> // fixed-size ints
+#include <cstring> // 'memcpy()'
+#include <istream> // related type
+#include <ostream> // related type
+#include <string> // related type
+#include <type_traits> // 'is_trivially_copyable'
+#include <vector> // related type
+
+
+
+// Binary I/O helpers
+// - Used by compact binary formats (replays, compiled levels)
+// - Values are stored in native byte order, files are meant to be read on the same kind of machine
+// - Strings are stored as 'uint32' length followed by characters
+namespace binary_io {
+
+template<typename T>
+void write_value(std::ostream &stream, const T &value) {
+	static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written as raw bytes.");
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void write_array(std::ostream &stream, const std::vector<T> &values) {
+	static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written as raw bytes.");
+	write_value(stream, static_cast<std::uint32_t>(values.size()));
+	stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+inline void write_string(std::ostream &stream, const std::string &str) {
+	write_value(stream, static_cast<std::uint32_t>(str.size()));
+	stream.write(str.data(), str.size());
+}
+
+template<typename T>
+bool read_value(std::istream &stream, T &value) {
+	static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read as raw bytes.");
+	return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+
+
+// # BinaryReader #
+// - Reads values from a buffer that holds the whole file
+// - Every read is bounds-checked, once a read fails all further reads fail as well
+class BinaryReader {
+public:
+	BinaryReader(const std::vector<char> &buffer) : data(buffer.data()), size(buffer.size()), cursor(0), failed(false) {}
+
+	template<typename T>
+	bool read(T &value) {
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read as raw bytes.");
+		if (!this->_reserve(sizeof(T))) return false;
+
+		std::memcpy(&value, this->data + this->cursor, sizeof(T));
+		this->cursor += sizeof(T);
+		return true;
+	}
+
+	template<typename T>
+	bool read_array(std::vector<T> &values) {
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read as raw bytes.");
+		std::uint32_t count;
+		if (!this->read(count) || !this->_reserve(static_cast<size_t>(count) * sizeof(T))) return false;
+
+		values.resize(count);
+		std::memcpy(values.data(), this->data + this->cursor, count * sizeof(T));
+		this->cursor += count * sizeof(T);
+		return true;
+	}
+
+	bool read_string(std::string &str) {
+		std::uint32_t length;
+		if (!this->read(length) || !this->_reserve(length)) return false;
+
+		str.assign(this->data + this->cursor, length);
+		this->cursor += length;
+		return true;
+	}
+
+	bool ok() const { return !this->failed; }
+	bool at_end() const { return this->cursor == this->size; }
+	size_t remaining() const { return this->size - this->cursor; }
+
+private:
+	const char* data;
+	size_t size;
+	size_t cursor;
+	bool failed;
+
+	bool _reserve(size_t bytes) {
+		if (this->failed || bytes > this->size - this->cursor) this->failed = true;
+		return !this->failed;
+	}
+};
+
+} // namespace binary_io
@@ -3,6 +3,7 @@
 #define PATH_CONTENT "content/"
 
 #define PATH_LEVELS "content/levels/"
+#define PATH_LEVELS_GENERATED "content/levels/generated/" // output of 'hatman_levelgen', levels are named 'generated/<name>'
 
 #define PATH_TILESETS "content/tilesets/"
 
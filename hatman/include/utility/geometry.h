@@ -4,8 +4,9 @@
 
 #include <initializer_list>
 #include <algorithm> // std::min(), std::max()
-#include <cstdlib> // abs(), rand()
+#include <cstdlib> // abs()
 
+#include "firstparty/UTL/random.hpp" // 'RandomGenerator' type
 #include "utility/vector2.hpp" // 'Vector2d' type used in 'dRect'
 
 
@@ -443,6 +444,15 @@ private:
 
 
 // Random functions
+// - Backed by a seedable xoshiro generator instead of 'std::rand()'
+// - Draw from the currently bound generator, 'Game' binds its own one which is reseeded for every level,
+//   so enemy AI and particles are reproducible for a given seed
+// - When no generator is bound a fallback one with a fixed default seed is used
+using RandomGenerator = utl::random::generators::Xoshiro256PP;
+
+void rand_bind(RandomGenerator* generator); // 'nullptr' binds the fallback generator
+RandomGenerator& rand_generator(); // currently bound generator
+
 bool rand_bool();
 int rand_int(int min, int max); // random int in [min, max] range
 double rand_double(); // random double in (0, 1] range
@@ -24,8 +24,14 @@ namespace natural {
 // performance::
 // - Consts related to performance
 namespace performance {
-	constexpr double MAX_FRAME_TIME_MS = 10.;
-		// physics start to slow down below 1000 / 40 == 25 FPS
+	constexpr double FIXED_TIMESTEP_MS = 1000. / 120.;
+		// simulation always advances in steps of that size, independent from the framerate
+	constexpr double MAX_FRAME_TIME_MS = 100.;
+		// frames longer than that are cut short so simulation doesn't spiral trying to catch up,
+		// game starts to slow down below 1000 / 100 == 10 FPS
+	constexpr double MAX_MERGED_STEPS = 4.;
+		// simulation that falls behind by more than that many steps advances that many steps at once,
+		// merged steps can be long enough for solids to move over a tile (that's handled by swept collisions)
 
 	constexpr int TILE_FREEZE_RANGE_X = static_cast<int>(0.5 * natural::WIDTH / natural::TILE_SIZE * natural::ZOOM) + 3;
 	constexpr int TILE_FREEZE_RANGE_Y = static_cast<int>(0.5 * natural::HEIGHT / natural::TILE_SIZE * natural::ZOOM) + 3;
@@ -33,11 +39,22 @@ namespace performance {
 	constexpr int TILE_DRAW_RANGE_X = static_cast<int>(0.5 * natural::WIDTH / natural::TILE_SIZE * natural::ZOOM) + 1;
 	constexpr int TILE_DRAW_RANGE_Y = static_cast<int>(0.5 * natural::HEIGHT / natural::TILE_SIZE * natural::ZOOM) + 1;
 		// tiles past that range (from player cell) are not drawn
+	constexpr int TILE_CHUNK_SIZE = 16;
+		// tile layers are baked into vertex arrays by chunks of 'TILE_CHUNK_SIZE x TILE_CHUNK_SIZE' tiles
 
 	constexpr int ENTITY_FREEZE_RANGE_X = (TILE_FREEZE_RANGE_X - 1) * natural::TILE_SIZE; // entities past that range are not updated
 	constexpr int ENTITY_FREEZE_RANGE_Y = (TILE_FREEZE_RANGE_Y - 1) * natural::TILE_SIZE;
 	constexpr int ENTITY_DRAW_RANGE_X = (TILE_DRAW_RANGE_X + 2) * natural::TILE_SIZE; // entities past that range are not drawn
 	constexpr int ENTITY_DRAW_RANGE_Y = (TILE_DRAW_RANGE_Y + 2) * natural::TILE_SIZE;
+
+	constexpr size_t PARALLEL_PHYSICS_MIN_ENTITIES = 64;
+		// entity physics runs on the thread pool once that many entities are in update range,
+		// below that waking workers costs more than it saves
+
+	constexpr double LEVEL_PRELOAD_DISTANCE = 8. * natural::TILE_SIZE;
+		// target level of a level change/switch starts loading in background once player is that close to its hitbox
+	constexpr size_t LEVEL_CACHE_MEMORY = 64 * 1024 * 1024;
+		// approximate memory recently left levels are allowed to occupy (largest levels take a few MB)
 }
 
 
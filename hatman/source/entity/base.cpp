@@ -1,9 +1,7 @@
 #include "entity/base.h"
 
-#include <fstream> // reading files
-#include "thirdparty/nlohmann.hpp" // parsing JSON
-
 #include "graphics/graphics.h" // access to texture loading
+#include "systems/game.h" // access to level broadphase
 #include "utility/filepaths.hpp" // path to textures
 
 
@@ -13,6 +11,7 @@ using namespace ntt;
 // # Entity #
 Entity::Entity(const Vector2d &position) :
 	position(position),
+	position_previous(position),
 	sprite(nullptr),
 	solid(nullptr),
 	health(nullptr),
@@ -24,12 +23,16 @@ bool Entity::update(Milliseconds elapsedTime) {
 	if (!this->enabled) return false;
 
 	if (this->sprite) { this->sprite->update(elapsedTime); }
-	if (this->solid) { this->solid->update(elapsedTime); }
 	if (this->health) { this->health->update(elapsedTime); }
+		// solid is updated by the level in a separate phase (see 'Level::update()')
 
 	return true;
 }
 
+bool Entity::physics_active() const {
+	return this->enabled && this->solid;
+}
+
 void Entity::draw() const {
 	if (!this->enabled) return;
 
@@ -56,13 +59,32 @@ bool Entity::marked_for_erase() const {
 	return this->erase_timer && this->erase_timer->finished(); // doesn't request ->finished() if timer doesn't exist
 }
 
+Milliseconds Entity::erase_delay() const {
+	return (this->erase_timer && this->erase_timer->was_set()) ? this->erase_timer->duration() : 0.;
+}
+
+void Entity::teleport(const Vector2d &newPosition) {
+	this->position = newPosition;
+	this->position_previous = newPosition; // otherwise drawing interpolates across the whole jump
+
+	if (!Game::READ->level) return;
+
+	// Broadphase binned the old position, query margin doesn't cover arbitrary jumps
+	Game::ACCESS->level->entities_grid.relocate(this);
+
+	if (this == Game::READ->level->player) Game::ACCESS->request_cameraSnap(); // camera follows the player
+}
+
 // Methods for parsing entity sprites from files
 void Entity::_parse_static_sprite(const std::string &entityName, const std::string &textureName) {
+	const auto region = Graphics::ACCESS->getTextureRegion_Entity(entityName + "/" + textureName + ".png");
+
 	this->sprite = std::make_unique<StaticSprite>(
 		this->position,
 		true,
 		false,
-		Graphics::ACCESS->getTexture(PATH_TEXTURES_ENTITIES + entityName + "/" + textureName + ".png")
+		*region.texture,
+		region.rect
 		);
 }
 
@@ -71,7 +93,7 @@ void Entity::_parse_animated_sprite(const std::string &entityName, const std::st
 		this->position,
 		true,
 		false,
-		_parse_animation(PATH_TEXTURES_ENTITIES + entityName + "/" + animationName)
+		AnimationStorage::ACCESS->getAnimation(PATH_TEXTURES_ENTITIES + entityName + "/" + animationName)
 		);
 }
 
@@ -85,7 +107,7 @@ void Entity::_parse_controllable_sprite(const std::string &entityName, std::init
 	bool defaultAnimationNotSet = true;
 
 	for (auto &name : animationNames) {
-		controllableSprite->animation_add(name, _parse_animation(PATH_TEXTURES_ENTITIES + entityName + "/" + name));
+		controllableSprite->animation_add(name, AnimationStorage::ACCESS->getAnimation(PATH_TEXTURES_ENTITIES + entityName + "/" + name));
 	
 		if (defaultAnimationNotSet && name == DEFAULT_ANIMATION_NAME) {
 			controllableSprite->animation_play(DEFAULT_ANIMATION_NAME, true);
@@ -95,30 +117,3 @@ void Entity::_parse_controllable_sprite(const std::string &entityName, std::init
 
 	this->sprite = std::move(controllableSprite);
 }
-
-
-
-/// THINK ABOUT CACHING ANIMATIONS
-Animation _parse_animation(const std::string &path) {
-	std::ifstream ifStream(path + ".json");
-	nlohmann::json JSON = nlohmann::json::parse(ifStream);
-
-	// Parse texture
-	sf::Texture &texture = Graphics::ACCESS->getTexture(path + ".png");
-
-	// Parse frames
-	std::vector<AnimationFrame> frames;
-
-	for (const auto &node : JSON["frames"]) {
-		frames.push_back(AnimationFrame{
-			make_srcRect(
-				node["frame"]["x"].get<int>(),
-				node["frame"]["y"].get<int>(),
-				node["frame"]["w"].get<int>(),
-				node["frame"]["h"].get<int>()),
-			node["duration"].get<double>()
-			});
-	}
-
-	return Animation(texture, std::move(frames));
-}
\ No newline at end of file
@@ -372,22 +372,21 @@ void Player::update_case_ATTACK([[maybe_unused]] Milliseconds elapsedTime) {
 				fire::CHAIN_RANGE_UP + fire::CHAIN_RANGE_DOWN
 			); // nasty geometry
 
-			for (auto& entity : Game::ACCESS->level->entities_killable)
-				if (attackHitbox.overlapsWithRect(entity->solid->getHitbox())) {
-					// Calculate dmg with respect to power shards
-					// Power Shard - increases dmg by <x>% (additevely)
-					const unsigned int numberOfPowerShards = this->inventory.count("twin_souls");
-					const double dmgModifier = 1. + numberOfPowerShards * artifacts::POWER_SHARD_DMG_BOOST;
-					const Damage damage = fire::CHAIN_0_DAMAGE * dmgModifier;
-
-					entity->health->applyDamage(damage);
-
-					if (this->health->faction != entity->health->faction) {
-						const auto sign = helpers::sign(entity->position.x - this->position.x);
-						entity->solid->addImpulse_Horizontal(fire::CHAIN_0_KNOCKBACK_X * sign);
-						entity->solid->addImpulse_Up(fire::CHAIN_0_KNOCKBACK_Y);
-					}
+			Game::ACCESS->level->entities_grid.for_each_in_rect(attackHitbox, [&](ntt::Entity* entity) {
+				// Calculate dmg with respect to power shards
+				// Power Shard - increases dmg by <x>% (additevely)
+				const unsigned int numberOfPowerShards = this->inventory.count("twin_souls");
+				const double dmgModifier = 1. + numberOfPowerShards * artifacts::POWER_SHARD_DMG_BOOST;
+				const Damage damage = fire::CHAIN_0_DAMAGE * dmgModifier;
+
+				entity->health->applyDamage(damage);
+
+				if (this->health->faction != entity->health->faction) {
+					const auto sign = helpers::sign(entity->position.x - this->position.x);
+					entity->solid->addImpulse_Horizontal(fire::CHAIN_0_KNOCKBACK_X * sign);
+					entity->solid->addImpulse_Up(fire::CHAIN_0_KNOCKBACK_Y);
 				}
+			});
 
 			sprite->animation_play("fire_chain_1");
 			++this->chain_progress;
@@ -404,16 +403,15 @@ void Player::update_case_ATTACK([[maybe_unused]] Milliseconds elapsedTime) {
 				fire::CHAIN_RANGE_UP + fire::CHAIN_RANGE_DOWN
 			); // nasty geometry
 
-			for (auto& entity : Game::ACCESS->level->entities_killable)
-				if (attackHitbox.overlapsWithRect(entity->solid->getHitbox())) {
-					entity->health->applyDamage(fire::CHAIN_2_DAMAGE);
+			Game::ACCESS->level->entities_grid.for_each_in_rect(attackHitbox, [&](ntt::Entity* entity) {
+				entity->health->applyDamage(fire::CHAIN_2_DAMAGE);
 
-					if (this->health->faction != entity->health->faction) {
-						const auto sign = helpers::sign(entity->position.x - this->position.x);
-						entity->solid->addImpulse_Horizontal(fire::CHAIN_2_KNOCKBACK_X * sign);
-						entity->solid->addImpulse_Up(fire::CHAIN_2_KNOCKBACK_Y);
-					}
+				if (this->health->faction != entity->health->faction) {
+					const auto sign = helpers::sign(entity->position.x - this->position.x);
+					entity->solid->addImpulse_Horizontal(fire::CHAIN_2_KNOCKBACK_X * sign);
+					entity->solid->addImpulse_Up(fire::CHAIN_2_KNOCKBACK_Y);
 				}
+			});
 
 			sprite->animation_play("fire_chain_2");
 			this->chain_progress = -1;
@@ -478,22 +476,21 @@ void Player::update_case_ULT([[maybe_unused]] Milliseconds elapsedTime) {
 				fire::ULT_RANGE_UP + fire::ULT_RANGE_DOWN
 			); // nasty geometry
 
-			for (auto& entity : Game::ACCESS->level->entities_killable)
-				if (attackHitbox.overlapsWithRect(entity->solid->getHitbox())) {
-					// Calculate dmg with respect to power shards
-					// Power Shard - increases dmg by <x>% (additevely)
-					const unsigned int numberOfPowerShards = this->inventory.count("twin_souls");
-					const double dmgModifier = 1. + numberOfPowerShards * artifacts::POWER_SHARD_DMG_BOOST;
-					const Damage damage = fire::ULT_DAMAGE * dmgModifier;
-
-					entity->health->applyDamage(damage);
-
-					if (this->health->faction != entity->health->faction) {
-						const auto sign = helpers::sign(entity->position.x - this->position.x);
-						entity->solid->addImpulse_Horizontal(fire::ULT_KNOCKBACK_X * sign);
-						entity->solid->addImpulse_Up(fire::ULT_KNOCKBACK_Y);
-					}
+			Game::ACCESS->level->entities_grid.for_each_in_rect(attackHitbox, [&](ntt::Entity* entity) {
+				// Calculate dmg with respect to power shards
+				// Power Shard - increases dmg by <x>% (additevely)
+				const unsigned int numberOfPowerShards = this->inventory.count("twin_souls");
+				const double dmgModifier = 1. + numberOfPowerShards * artifacts::POWER_SHARD_DMG_BOOST;
+				const Damage damage = fire::ULT_DAMAGE * dmgModifier;
+
+				entity->health->applyDamage(damage);
+
+				if (this->health->faction != entity->health->faction) {
+					const auto sign = helpers::sign(entity->position.x - this->position.x);
+					entity->solid->addImpulse_Horizontal(fire::ULT_KNOCKBACK_X * sign);
+					entity->solid->addImpulse_Up(fire::ULT_KNOCKBACK_Y);
 				}
+			});
 
 			sprite->animation_play("fire_ult_1");
 			this->chain_progress = -1;
@@ -547,71 +544,13 @@ void Player::jump_down_end() {
 }
 
 void Player::horizontal_blink(Orientation direction, double range) {
-	const auto playerSize = this->solid->getHitbox().getSize();
-
-	// Ensure we don't teleport through terrain, adjust tp range if necesary
-	const Vector2 centerIndex = helpers::divide32(this->position);
-
-	if (direction == Orientation::RIGHT) {
-		// If there is no obstacles player right side will appear here
-		double playerRightGoesTo = this->position.x + playerSize.x / 2. + range;
-
-		// We only need to check 3-tile tall strip in a blink direction for collisions
-		const int leftBound = centerIndex.x;
-		const int rightBound = std::min(helpers::divide32(playerRightGoesTo), Game::READ->level->getSizeX() - 1);
-		const int upperBound = std::max(centerIndex.y - 1, 0);
-		const int lowerBound = std::min(centerIndex.y + 1, Game::READ->level->getSizeY() - 1);
-
-		// Area that would be drawn if we 'continuously dragged' player hitbox to a new postion
-		const dRect areaToCheck(
-			this->solid->getHitbox().getCornerTopLeft(),
-			playerSize + Vector2d(range, 0.)
-		);
-
-		// Go through tiles and determine where player would end up if we tried to 'continuously drag' hitbox
-		for (int X = leftBound; X <= rightBound; ++X)
-			for (int Y = upperBound; Y <= lowerBound; ++Y) {
-				const auto tile = Game::ACCESS->level->getTile(X, Y);
-
-				if (tile && tile->hitbox)
-					for (const auto hitboxRect : tile->hitbox->rectangles)
-						if (!hitboxRect.is_platform && hitboxRect.rect.overlapsWithRect(areaToCheck) && hitboxRect.rect.getLeft() < playerRightGoesTo)
-							playerRightGoesTo = hitboxRect.rect.getLeft();
-			}
+	// Ensure we don't teleport through terrain, blink acts as if hitbox was 'continuously dragged' to a new position
+	// and stops at the first obstacle on the way (platforms don't stop horizontal movement)
+	const Vector2d movement(sign(direction) * range, 0.);
 
-		// Profit
-		this->position.x = playerRightGoesTo - playerSize.x / 2.;
-	}
-	else {
-		// If there is no obstacles player left side will appear here
-		double playerLeftGoesTo = this->position.x - playerSize.x / 2. - range;
-
-		// We only need to check 3-tile tall strip in a blink direction for collisions
-		const int leftBound = std::max(helpers::divide32(playerLeftGoesTo), 0);
-		const int rightBound = centerIndex.x;
-		const int upperBound = std::max(centerIndex.y - 1, 0);
-		const int lowerBound = std::min(centerIndex.y + 1, Game::READ->level->getSizeY() - 1);
-
-		// Area that would be drawn if we 'continuously dragged' player hitbox to a new postion
-		const dRect areaToCheck(
-			this->solid->getHitbox().getCornerTopLeft() - Vector2d(range, 0.),
-			playerSize + Vector2d(range, 0.)
-		);
-
-		// Go through tiles and determine where player would end up if we tried to 'continuously drag' hitbox
-		for (int X = leftBound; X <= rightBound; ++X)
-			for (int Y = upperBound; Y <= lowerBound; ++Y) {
-				const auto tile = Game::ACCESS->level->getTile(X, Y);
-
-				if (tile && tile->hitbox)
-					for (const auto hitboxRect : tile->hitbox->rectangles)
-						if (!hitboxRect.is_platform && hitboxRect.rect.overlapsWithRect(areaToCheck) && hitboxRect.rect.getRight() > playerLeftGoesTo)
-							playerLeftGoesTo = hitboxRect.rect.getRight();
-			}
+	const auto sweep = this->solid->sweep_Tiles(movement);
 
-		// Profit
-		this->position.x = playerLeftGoesTo + playerSize.x / 2.;
-	}
+	this->teleport(this->position + movement * sweep.time_of_impact);
 }
 
 void Player::update_cameraTrapPos(Milliseconds elapsedTime) {
@@ -651,7 +590,12 @@ void Player::draw() const {
 
 	Creature::draw();
 
+	const int entityLayer = Graphics::READ->get_layer();
+	Graphics::ACCESS->set_layer(world_layers::ENTITY_EFFECTS); // effects should be above entities of different textures
+
 	this->effect_sprite->draw();
+
+	Graphics::ACCESS->set_layer(entityLayer);
 }
 
 void Player::deathTransition() {
@@ -662,12 +606,12 @@ void Player::deathTransition() {
 	if (this->death_transition_performed) return;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 
 	Game::ACCESS->request_levelReload();
@@ -713,7 +657,7 @@ void Player::_init_effect_sprite(const std::string &folder, std::initializer_lis
 	bool defaultAnimationNotSet = true;
 
 	for (auto &name : animationNames) {
-		controllableSprite->animation_add(name, _parse_animation(PATH_TEXTURES_ENTITIES + folder + "/" + name));
+		controllableSprite->animation_add(name, AnimationStorage::ACCESS->getAnimation(PATH_TEXTURES_ENTITIES + folder + "/" + name));
 
 		if (defaultAnimationNotSet && name == DEFAULT_ANIMATION_NAME) {
 			controllableSprite->animation_play(DEFAULT_ANIMATION_NAME, true);
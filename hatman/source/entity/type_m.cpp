@@ -111,7 +111,7 @@ bool m_type::Enemy::update(Milliseconds elapsedTime) {
 	if (!Creature::update(elapsedTime) || !this->creature_is_alive) return false;
 
 	// Check validity of the target (aka target still alive/exists)
-	if (this->target && !Game::ACCESS->level->entities_type[TypeId::CREATURE].count(this->target)) {
+	if (this->target && !Game::ACCESS->level->entities.get(this->target_handle)) {
 		this->target = nullptr;
 		this->state_change(this->default_deaggroed_state);
 		this->deaggroTransition();
@@ -133,11 +133,12 @@ bool m_type::Enemy::update(Milliseconds elapsedTime) {
 	else {
 		this->update_when_deaggroed(elapsedTime);
 
-		for (const auto& entity : Game::ACCESS->level->entities_type[TypeId::CREATURE]) {
+		for (const auto& entity : Game::ACCESS->level->entities.group(EntityGroup::CREATURE)) {
 			const auto creature = static_cast<Creature*>(entity); // we 100% know that it's creature
 
 			if (creature->health->faction != this->health->faction && this->aggroCondition(creature)) {
 				this->target = creature;
+				this->target_handle = creature->handle;
 				this->state_change(this->default_aggroed_state);
 				this->aggroTransition();
 			}
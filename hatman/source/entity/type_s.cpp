@@ -47,13 +47,28 @@ bool s_type::Projectile::update(Milliseconds elapsedTile) {
 	return true;
 }
 
+bool s_type::Projectile::physics_active() const {
+	return Entity::physics_active() && this->delay.finished();
+}
+
 // Checks
 bool s_type::Projectile::checkEntityCollision() {
 	return this->solid->getFirstCollision_DifferentFactionEntity(this->damage.faction);
 }
 
 bool s_type::Projectile::checkTerrainCollision() {
-	return this->collides_with_terrain && this->solid->getFirstCollision_Tile();
+	if (!this->collides_with_terrain) return false;
+
+	// Sweep the last step, fast projectiles could fly through thin tiles otherwise
+	const Vector2d step = this->position - this->position_previous;
+	const auto sweep = this->solid->sweep_Tiles(dRect(this->position_previous, this->solid->hitboxSize, true), step);
+
+	if (sweep.hit()) {
+		this->position = this->position_previous + step * sweep.time_of_impact; // explode at the point of impact
+		return true;
+	}
+
+	return this->solid->hasCollision_Tile();
 }
 
 // Effects
@@ -64,16 +79,15 @@ void s_type::Projectile::onCollision() {
 	const auto area = dRect(this->position, this->AOE, true);
 
 	// Look for entities that should be damaged, deal damage and knockback
-	for (auto &entity : Game::ACCESS->level->entities_killable)
-		if (area.overlapsWithRect(entity->solid->getHitbox())) {
-			entity->health->applyDamage(this->damage);
-
-			// Don't knockback friendly faction
-			if (this->damage.faction != entity->health->faction) {
-				const auto knockbackDirection = (entity->position - this->position).normalized();
-				entity->solid->addImpulse(knockbackDirection * this->knockback);
-			}		
+	Game::ACCESS->level->entities_grid.for_each_in_rect(area, [&](ntt::Entity* entity) {
+		entity->health->applyDamage(this->damage);
+
+		// Don't knockback friendly faction
+		if (this->damage.faction != entity->health->faction) {
+			const auto knockbackDirection = (entity->position - this->position).normalized();
+			entity->solid->addImpulse(knockbackDirection * this->knockback);
 		}
+	});
 
 	this->_sprite->animation_play("explosion");
 	if (this->collision_sound) this->collision_sound->play();
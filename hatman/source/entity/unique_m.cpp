@@ -302,12 +302,12 @@ void m::enemy::Sludge::deathTransition() {
 	using namespace Sludge_consts;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 }
 
@@ -554,12 +554,12 @@ void m::enemy::Worm::deathTransition() {
 	using namespace Worm_consts;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 }
 
@@ -818,12 +818,12 @@ void m::enemy::Golem::deathTransition() {
 	using namespace Golem_consts;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 }
 
@@ -1611,12 +1611,12 @@ void m::enemy::Devourer::deathTransition() {
 	using namespace Devourer_consts;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 }
 
@@ -1800,12 +1800,12 @@ void m::enemy::SpiritBomber::deathTransition() {
 	using namespace SpiritBomber_consts;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 }
 
@@ -1994,12 +1994,12 @@ void m::enemy::CultistMage::deathTransition() {
 	using namespace CultistMage_consts;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 }
 
@@ -2356,12 +2356,12 @@ void m::enemy::Hellhound::deathTransition() {
 	using namespace Hellhound_consts;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 }
 
@@ -2706,12 +2706,12 @@ void m::enemy::Tentacle::deathTransition() {
 	using namespace Tentacle_consts;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 }
 
@@ -3239,11 +3239,11 @@ void m::enemy::BossMage2::update_when_aggroed([[maybe_unused]] Milliseconds elap
 					// Check that tentacle has ground underneath
 					const Vector2d left_corner = spawned_tentacle->solid->getHitbox().getCornerBottomLeft() + SUMMON_TENTACLE_VALIDITY_CHECK_EPSILON;
 					const Vector2 tile_index_left_corner = helpers::divide32(left_corner);
-					const bool tile_present_under_left = Game::READ->level->getTile(tile_index_left_corner.x, tile_index_left_corner.y + 1);
+					const bool tile_present_under_left = Game::READ->level->hasTile(tile_index_left_corner.x, tile_index_left_corner.y + 1);
 
 					const Vector2d right_corner = spawned_tentacle->solid->getHitbox().getCornerBottomRight() + SUMMON_TENTACLE_VALIDITY_CHECK_EPSILON;
 					const Vector2 tile_index_right_corner = helpers::divide32(right_corner);
-					const bool tile_present_under_right = Game::READ->level->getTile(tile_index_right_corner.x, tile_index_right_corner.y + 1);
+					const bool tile_present_under_right = Game::READ->level->hasTile(tile_index_right_corner.x, tile_index_right_corner.y + 1);
 
 					if (spawn_allowed) std::cout
 						<< "Tentacle [" << i << "]\n"
@@ -3614,11 +3614,11 @@ void m::enemy::BossMage3::update_when_aggroed([[maybe_unused]] Milliseconds elap
 					// Check that tentacle has ground underneath
 					const Vector2d left_corner = spawned_tentacle->solid->getHitbox().getCornerBottomLeft() + SUMMON_TENTACLE_VALIDITY_CHECK_EPSILON;
 					const Vector2 tile_index_left_corner = helpers::divide32(left_corner);
-					const bool tile_present_under_left = Game::READ->level->getTile(tile_index_left_corner.x, tile_index_left_corner.y + 1);
+					const bool tile_present_under_left = Game::READ->level->hasTile(tile_index_left_corner.x, tile_index_left_corner.y + 1);
 
 					const Vector2d right_corner = spawned_tentacle->solid->getHitbox().getCornerBottomRight() + SUMMON_TENTACLE_VALIDITY_CHECK_EPSILON;
 					const Vector2 tile_index_right_corner = helpers::divide32(right_corner);
-					const bool tile_present_under_right = Game::READ->level->getTile(tile_index_right_corner.x, tile_index_right_corner.y + 1);
+					const bool tile_present_under_right = Game::READ->level->hasTile(tile_index_right_corner.x, tile_index_right_corner.y + 1);
 
 					if (!tile_present_under_left || !tile_present_under_right) {
 						spawn_allowed = false;
@@ -3740,12 +3740,12 @@ void m::enemy::BossMage3::deathTransition() {
 	using namespace BossMage3_consts;
 
 	for (int i = 0; i < PARTICLE_COUNT; ++i) {
-		Game::ACCESS->level->spawn(std::make_unique<s::particle::OnDeathParticle>(
+		Game::ACCESS->level->particles.emit(
 			this->position,
 			Vector2d(rand_double(-PARTICLE_MAX_SPEED_X, PARTICLE_MAX_SPEED_X), rand_double(-PARTICLE_MAX_SPEED_Y, 0.)),
 			colors::SH_BLACK,
 			rand_double(PARTICLE_DURATION_MIN, PARTICLE_DURATION_MAX)
-			));
+		);
 	}
 
 	// Go to ending screen, the game is finished
@@ -3890,7 +3890,9 @@ void m::destructible::OrbOfBetrayal::effect() {
 	using namespace OrbOfBetrayal_consts;
 
 	// Damage creatures of the same faction that are in the radius
-	for (const auto& entity : Game::ACCESS->level->entities_type[TypeId::CREATURE]) {
+	Game::ACCESS->level->entities_grid.for_each_in_radius(this->position, AOE_RADIUS, [&](ntt::Entity* entity) {
+		if (!Game::ACCESS->level->entities.in_group(entity->handle, EntityGroup::CREATURE)) return; // grid holds all killable entities
+
 		const auto creature = static_cast<ntt::m_type::Creature*>(entity); // we 100% know that it's creature
 
 		const bool factions_are_same = (creature->health->faction == this->health->faction);
@@ -3899,7 +3901,7 @@ void m::destructible::OrbOfBetrayal::effect() {
 		if (factions_are_same && in_radius) {
 			creature->health->applyDamage(DAMAGE);
 		}
-	}
+	});
 
 	// Play explosion animation
 	this->_sprite->animation_play("explosion");
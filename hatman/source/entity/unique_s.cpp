@@ -42,31 +42,3 @@ void projectile::Fireball::onCollision() {
 	Projectile::onCollision();
 }
 
-
-
-/* ### particle:: ### */
-
-// # OnDeathParticle #
-namespace OnDeathParticle_consts {
-	constexpr double MASS = 20;
-	constexpr double FRICTION = 0.4;
-}
-
-particle::OnDeathParticle::OnDeathParticle(const Vector2d &position, const Vector2d &speed, const RGBColor &color, Milliseconds lifetime) :
-	Particle(position, lifetime),
-	color(color)
-{
-	// Init modules
-	this->_init_sprite(false, "[particle]{on_death_particle}");
-
-	this->sprite->color_mod = this->color;
-
-	this->_optinit_solid(
-		Vector2(3, 3),
-		SolidFlags::SOLID | SolidFlags::AFFECTED_BY_GRAVITY,
-		OnDeathParticle_consts::MASS,
-		OnDeathParticle_consts::FRICTION
-	);
-
-	this->solid->speed = speed;
-}
\ No newline at end of file
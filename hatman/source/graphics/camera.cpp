@@ -43,28 +43,24 @@ void Camera::set_zoom(double zoom) {
 	this->FOV = (natural::DIMENSIONS * zoom).to_Vector2();
 }
 
-void Camera::draw_sprite(sf::Sprite &sprite) {
-	// Candle sprite position
-	const sf::Vector2f minusCameraCornerPos(
-		static_cast<float>(this->FOV.x / 2. - this->position.x),
-		static_cast<float>(this->FOV.y / 2. - this->position.y)
-	); // position of top-left corner of the camera
-
-	sprite.move(minusCameraCornerPos);
-
-	// Set up camera view
-	const auto FOV_size = Graphics::READ->camera->get_FOV_size();
+sf::View Camera::get_view() const {
+	// Camera corner is rounded to whole pixels so every sprite gets shifted by the same integer offset
+	const Vector2d corner = this->get_FOV_corner();
 
 	sf::View camera_view;
 	camera_view.setCenter(
-		static_cast<float>(FOV_size.x / 2.),
-		static_cast<float>(FOV_size.y / 2.)
+		std::floor(static_cast<float>(corner.x) + .5f) + static_cast<float>(this->FOV.x / 2.),
+		std::floor(static_cast<float>(corner.y) + .5f) + static_cast<float>(this->FOV.y / 2.)
 	);
 	camera_view.setSize(
-		static_cast<float>(FOV_size.x),
-		static_cast<float>(FOV_size.y)
+		static_cast<float>(this->FOV.x),
+		static_cast<float>(this->FOV.y)
 	);
 
+	return camera_view;
+}
+
+void Camera::draw_sprite(sf::Sprite &sprite) {
 	// !!! Fix for the rounding issue that causes vertical black lines !!!
 	// !!! to sometimes appear on certain camera coords                !!!
 	const float scaling_factor = static_cast<float>(Graphics::READ->scaling_factor());
@@ -72,8 +68,10 @@ void Camera::draw_sprite(sf::Sprite &sprite) {
 	sf::Vector2f oldPosition = sprite.getPosition();
 	sprite.setPosition(std::floor(oldPosition.x + .5f / scaling_factor), std::floor(oldPosition.y + .5f / scaling_factor));
 
-	Graphics::ACCESS->window.setView(camera_view);
+	// Queue (sprite is already in level coords, view is set once per pass)
+	Graphics::ACCESS->queue_sprite(sprite, RenderPass::WORLD);
+}
 
-	// Draw
-	Graphics::ACCESS->window_draw_sprite(sprite);
+void Camera::draw_vertices(const sf::VertexArray &vertices, const sf::Texture* texture) {
+	Graphics::ACCESS->queue_vertices(vertices, texture, RenderPass::WORLD);
 }
\ No newline at end of file
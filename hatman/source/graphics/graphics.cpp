@@ -5,6 +5,7 @@
 #include <iostream>
 
 #include "utility/globalconsts.hpp" // natural consts
+#include "utility/filepaths.hpp" // texture directories (atlas packing)
 
 // # Graphics #
 const Graphics* Graphics::READ;
@@ -22,6 +23,7 @@ Graphics::Graphics(int width, int height, sf::Uint32 style) :
 	Graphics::READ = this; // init global access
 	Graphics::ACCESS = this;
 
+#ifndef HATMAN_HEADLESS
 	// When borderless window has the exact same resolution as the screen
 	// some OSs (notably Windows 10) perform "fullscreen optimization" that
 	// replaces borderless fullscreen window with regular fullscreen. To avoid it
@@ -46,7 +48,13 @@ Graphics::Graphics(int width, int height, sf::Uint32 style) :
 	this->icon.loadFromFile("icon.png");
 	this->window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
 
-	this->window.setFramerateLimit(200);
+	this->window.setVerticalSyncEnabled(true); // simulation runs at a fixed rate, rendering is capped by the monitor
+
+	// Pack textures that get drawn often and in large numbers into an atlas
+	this->atlas.pack({ PATH_TEXTURES_ENTITIES, PATH_TEXTURES_ITEMS, PATH_TEXTURES_GUI });
+#else
+	(void)style; // no window, no atlas, textures are never loaded
+#endif
 
 	this->camera = std::make_unique<Camera>();
 	this->gui = std::make_unique<Gui>();
@@ -56,8 +64,10 @@ Graphics::Graphics(int width, int height, sf::Uint32 style) :
 sf::Texture& Graphics::getTexture(const std::string &filePath) {
 	if (!this->loadedTextures.count(filePath)) { // image is not loaded => load it, add to the map
 		sf::Texture texture;
+#ifndef HATMAN_HEADLESS
 		texture.loadFromFile(filePath);
 		/// ADD ERROR HANDLING
+#endif
 
 		this->loadedTextures[filePath] = std::move(texture);
 	}
@@ -81,15 +91,79 @@ sf::Texture& Graphics::getTexture_GUI(const std::string &name) {
 	return this->getTexture("content/textures/gui/" + name);
 }
 
+TextureRegion Graphics::getTextureRegion(const std::string &filePath) {
+	if (const auto region = this->atlas.find(filePath)) return *region;
+
+	// Not in the atlas => region covers the whole texture
+	sf::Texture &texture = this->getTexture(filePath);
+
+	return TextureRegion{ &texture, make_srcRect(0, 0, texture.getSize().x, texture.getSize().y) };
+}
+TextureRegion Graphics::getTextureRegion_Entity(const std::string &name) {
+	return this->getTextureRegion(PATH_TEXTURES_ENTITIES + name);
+}
+TextureRegion Graphics::getTextureRegion_Item(const std::string &name) {
+	return this->getTextureRegion(PATH_TEXTURES_ITEMS + name);
+}
+TextureRegion Graphics::getTextureRegion_GUI(const std::string &name) {
+	return this->getTextureRegion(PATH_TEXTURES_GUI + name);
+}
+
 // Rendering
 void Graphics::window_clear() {
+#ifndef HATMAN_HEADLESS
 	this->window.clear();
+#endif
 }
-void Graphics::window_draw_sprite(sf::Sprite &sprite) {
-	this->window.draw(sprite);
+
+void Graphics::begin_world_pass() {
+	this->view_world = this->camera->get_view();
+}
+
+void Graphics::begin_overlay_pass() {
+	this->view_overlay = this->gui->get_view();
 }
+
 void Graphics::window_display() {
+	this->last_draw_calls = 0;
+
+#ifndef HATMAN_HEADLESS
+	for (size_t pass = 0; pass < RENDER_PASS_COUNT; ++pass) {
+		this->window.setView(static_cast<RenderPass>(pass) == RenderPass::WORLD ? this->view_world : this->view_overlay);
+
+		this->batches[pass].flush(this->window);
+
+		this->last_draw_calls += this->batches[pass].draw_calls();
+	}
+
 	this->window.display();
+#else
+	for (auto &batch : this->batches) batch.clear(); // nothing to draw to
+#endif
+}
+
+void Graphics::queue_sprite(const sf::Sprite &sprite, RenderPass pass) {
+	const int layer = (pass == RenderPass::WORLD) ? this->world_layer : 0;
+
+	this->batches[static_cast<size_t>(pass)].add_sprite(sprite, layer);
+}
+
+void Graphics::queue_vertices(const sf::VertexArray &vertices, const sf::Texture* texture, RenderPass pass) {
+	const int layer = (pass == RenderPass::WORLD) ? this->world_layer : 0;
+
+	this->batches[static_cast<size_t>(pass)].add_vertices(vertices, texture, layer);
+}
+
+void Graphics::set_layer(int layer) {
+	this->world_layer = layer;
+}
+
+int Graphics::get_layer() const {
+	return this->world_layer;
+}
+
+size_t Graphics::draw_calls() const {
+	return this->last_draw_calls;
 }
 
 int Graphics::width() const { return this->rendering_width; }
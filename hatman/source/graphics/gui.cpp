@@ -8,14 +8,16 @@
 #include "systems/game.h" // access to game state
 #include "systems/controls.h" // access to control keys
 #include "systems/saver.h" // checking wheter save exists upon main menu startup
+#include "systems/profiler.h" // profiling zones
 
 
 // # Font #
-Font::Font(sf::Texture* texture, const Vector2 &size, const Vector2d &gap) :
+Font::Font(const TextureRegion &region, const Vector2 &size, const Vector2d &gap) :
+	texture_region(region),
 	font_size(size),
 	font_gap(gap)
 {
-	this->sprite.setTexture(*texture);
+	this->sprite.setTexture(*this->texture_region.texture);
 }
 
 Vector2d Font::draw_symbol(const Vector2d &position, char symbol, bool overlay) {
@@ -72,12 +74,12 @@ Vector2d Font::draw_symbol(const Vector2d &position, char symbol, bool overlay)
 		source_pos.set(0, 2);
 	}
 	
-	this->sprite.setTextureRect(sf::IntRect(
+	this->sprite.setTextureRect(this->texture_region.subrect(sf::IntRect(
 		(this->font_size.x + 2) * source_pos.x,
 		(this->font_size.y + 2) * source_pos.y,
 		this->font_size.x + 2,
 		this->font_size.y + 2
-	));
+	)));
 
 	this->sprite.setPosition(
 		static_cast<float>(position.x - 1),
@@ -310,10 +312,10 @@ GUI_FPSCounter::GUI_FPSCounter(Font* font) :
 	currentFPS(0)
 {}
 
-void GUI_FPSCounter::update([[maybe_unused]] Milliseconds elapsedTime) {
+void GUI_FPSCounter::count_frame(Milliseconds frameTime) {
 	using namespace GUI_FPSCounter_consts;
 
-	this->time_elapsed += Game::READ->_true_time_elapsed; // FPS is calculated independent from timescale!
+	this->time_elapsed += frameTime; // FPS is calculated independent from timescale!
 	++this->frames_elapsed;
 
 	if (this->time_elapsed > UPDATE_RATE) {
@@ -758,7 +760,7 @@ GUI_MainMenu::GUI_MainMenu(Font* font) :
 {
 	using namespace MainMenu_consts;
 
-	this->sprite.setTexture(Graphics::ACCESS->getTexture_GUI("main_menu_background.png"));
+	Graphics::ACCESS->getTextureRegion_GUI("main_menu_background.png").apply(this->sprite);
 	this->sprite.setScale(
 		static_cast<float>(natural::DIMENSIONS.x / TEXTURE_WIDTH),
 		static_cast<float>(natural::DIMENSIONS.y / TEXTURE_HEIGHT)
@@ -1619,7 +1621,8 @@ void GUI_Inventory::draw_old() const { // TEMP: Remove
 GUI_PlayerHealthbar::GUI_PlayerHealthbar() :
 	percentage(1.)
 {
-	sprite.setTexture(Graphics::ACCESS->getTexture_GUI("player_healthbar.png"));
+	this->texture_region = Graphics::ACCESS->getTextureRegion_GUI("player_healthbar.png");
+	this->sprite.setTexture(*this->texture_region.texture);
 }
 
 void GUI_PlayerHealthbar::update([[maybe_unused]] Milliseconds elapsedTime) {
@@ -1644,12 +1647,12 @@ void GUI_PlayerHealthbar::draw() {
 	// Draw fill
 	const int fillDisplayedHeight = static_cast<int>(FILL_SIZE.y * this->percentage);
 
-	sprite.setTextureRect(sf::IntRect(
+	sprite.setTextureRect(this->texture_region.subrect(sf::IntRect(
 		FILL_CORNER.x,
 		FILL_CORNER.y + FILL_SIZE.y - fillDisplayedHeight,
 		FILL_SIZE.x,
 		fillDisplayedHeight
-	));
+	)));
 
 	sprite.setPosition(sf::Vector2f(
 		static_cast<float>(HEALTHBAR_LEFT + FILL_ALIGMENT.x),
@@ -1661,12 +1664,12 @@ void GUI_PlayerHealthbar::draw() {
 	Graphics::ACCESS->gui->draw_sprite(this->sprite);
 
 	// Draw border
-	sprite.setTextureRect(sf::IntRect(
+	sprite.setTextureRect(this->texture_region.subrect(sf::IntRect(
 		BORDER_CORNER.x,
 		BORDER_CORNER.y,
 		BORDER_SIZE.x,
 		BORDER_SIZE.y
-	));
+	)));
 
 	sprite.setPosition(
 		static_cast<float>(HEALTHBAR_LEFT),
@@ -1723,7 +1726,8 @@ namespace GUI_PlayerCharges_consts {
 GUI_PlayerCharges::GUI_PlayerCharges() {
 	using namespace GUI_PlayerCharges_consts;
 
-	this->sprite.setTexture(Graphics::ACCESS->getTexture_GUI("player_charge.png"));
+	this->texture_region = Graphics::ACCESS->getTextureRegion_GUI("player_charge.png");
+	this->sprite.setTexture(*this->texture_region.texture);
 }
 
 void GUI_PlayerCharges::update([[maybe_unused]] Milliseconds elapsedTime) {}
@@ -1749,7 +1753,7 @@ void GUI_PlayerCharges::draw() {
 
 	// Draw fill
 	for (uint i = 0; i < current; ++i) {
-		this->sprite.setTextureRect(FILL_SOURCE_RECT);
+		this->sprite.setTextureRect(this->texture_region.subrect(FILL_SOURCE_RECT));
 
 		this->sprite.setPosition(
 			static_cast<float>(start + i * (BORDER_DEST_WIDTH + gap)),
@@ -1766,7 +1770,7 @@ void GUI_PlayerCharges::draw() {
 
 	// Draw borders
 	for (uint i = 0; i < max; ++i) {
-		this->sprite.setTextureRect(BORDER_SOURCE_RECT);
+		this->sprite.setTextureRect(this->texture_region.subrect(BORDER_SOURCE_RECT));
 
 		this->sprite.setPosition(
 			static_cast<float>(start + i * (BORDER_DEST_WIDTH + gap)),
@@ -1786,10 +1790,11 @@ void GUI_PlayerCharges::draw() {
 
 // # GUI_PlayerPortrait
 GUI_PlayerPortrait::GUI_PlayerPortrait() {
-	sprite.setTexture(Graphics::ACCESS->getTexture_GUI("player_portrait.png"));
+	const auto region = Graphics::ACCESS->getTextureRegion_GUI("player_portrait.png");
+	region.apply(this->sprite);
 
 	// Set size based on texture
-	this->size = Vector2d(sprite.getTexture()->getSize().x, sprite.getTexture()->getSize().y);
+	this->size = Vector2d(region.rect.w, region.rect.h);
 }
 
 void GUI_PlayerPortrait::update([[maybe_unused]] Milliseconds elapsedTime) {}
@@ -1812,7 +1817,7 @@ void GUI_PlayerPortrait::draw() {
 GUI_Fade::GUI_Fade(const RGBColor &color) :
 	color(color)
 {
-	this->sprite.setTexture(Graphics::ACCESS->getTexture_GUI("fade.png"));
+	Graphics::ACCESS->getTextureRegion_GUI("fade.png").apply(this->sprite);
 		// a texture of literally white screen
 }
 
@@ -1918,13 +1923,15 @@ Gui::Gui() :
 	std::cout << "Creating GUI graphics...\n";
 
 	this->fonts["BLOCKY"] = (std::make_unique<Font>(
-		&Graphics::ACCESS->getTexture_GUI("font.png"),
+		Graphics::ACCESS->getTextureRegion_GUI("font.png"),
 		Vector2(5, 5),
 		Vector2d(1., 2.)
 		));
 }
 
 void Gui::update(Milliseconds elapsedTime) {
+	const FrameProfiler::Zone zone("Gui::update");
+
 	// Handle GUI-realted inputs handling goes here
 	auto &game = Game::ACCESS;
 	auto &input = game->input;
@@ -1946,10 +1953,13 @@ void Gui::update(Milliseconds elapsedTime) {
 	if (input.key_pressed(Controls::READ->F3) && game->is_running()) {
 		game->request_toggleF3();
 	}
+	// Toggling profiler
+	if (input.key_pressed(Controls::READ->F4)) {
+		game->request_toggleProfiler();
+	}
 
 	if (this->fade) { this->fade->update(elapsedTime); }
 
-	if (this->FPS_counter) this->FPS_counter->update(elapsedTime);
 	if (this->main_menu) this->main_menu->update(elapsedTime);
 	if (this->ending_screen) this->ending_screen->update(elapsedTime);
 	if (this->esc_menu) this->esc_menu->update(elapsedTime);
@@ -1963,6 +1973,8 @@ void Gui::update(Milliseconds elapsedTime) {
 }
 
 void Gui::draw() const {
+	const FrameProfiler::Zone zone("Gui::draw");
+
 	if (this->fade && !this->fade_override_gui) this->fade->draw(); // if fade doesn't override GUI
 
 	if (this->FPS_counter && (Game::READ->show_fps_counter || Game::READ->toggle_F3)) this->FPS_counter->draw();
@@ -2020,6 +2032,10 @@ void Gui::FPSCounter_off() {
 	this->FPS_counter.reset();
 }
 
+void Gui::FPSCounter_countFrame(Milliseconds frameTime) {
+	if (this->FPS_counter) this->FPS_counter->count_frame(frameTime);
+}
+
 // Main menu
 void Gui::MainMenu_on() {
 	if (!this->main_menu)
@@ -2163,8 +2179,7 @@ void Gui::LevelName_off() {
 }
 
 
-void Gui::draw_sprite(sf::Sprite &sprite) {
-	// Set up GUI view
+sf::View Gui::get_view() const {
 	sf::View gui_view;
 	gui_view.setCenter(
 		static_cast<float>(natural::DIMENSIONS.x / 2.), 
@@ -2175,8 +2190,9 @@ void Gui::draw_sprite(sf::Sprite &sprite) {
 		static_cast<float>(natural::DIMENSIONS.y)
 	);
 
-	Graphics::ACCESS->window.setView(gui_view);
+	return gui_view;
+}
 
-	// Draw
-	Graphics::ACCESS->window_draw_sprite(sprite);
-}
\ No newline at end of file
+void Gui::draw_sprite(sf::Sprite &sprite) {
+	Graphics::ACCESS->queue_sprite(sprite, RenderPass::OVERLAY);
+}
@@ -0,0 +1,89 @@
+#include "graphics/sprite_batch.h"
+
+#include <algorithm> // 'sort()'
+#include <cmath> // 'abs()'
+#include <functional> // 'less<>' (total order for texture ptrs)
+
+
+
+// # SpriteBatch #
+SpriteBatch::SpriteBatch(bool sortByTexture) :
+	sort_by_texture(sortByTexture)
+{}
+
+void SpriteBatch::add_sprite(const sf::Sprite &sprite, int layer) {
+	const sf::IntRect &rect = sprite.getTextureRect();
+	const sf::Transform &transform = sprite.getTransform();
+	const sf::Color color = sprite.getColor();
+
+	const float width = static_cast<float>(std::abs(rect.width));
+	const float height = static_cast<float>(std::abs(rect.height));
+
+	const float left = static_cast<float>(rect.left);
+	const float top = static_cast<float>(rect.top);
+	const float right = left + static_cast<float>(rect.width);
+	const float bottom = top + static_cast<float>(rect.height);
+
+	this->items.push_back(Item{ layer, sprite.getTexture(), this->items.size(), this->quads.size(), nullptr });
+
+	// Same vertices 'sf::Sprite' would produce, but in 'sf::Quads' order
+	this->quads.push_back(sf::Vertex(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(left, top)));
+	this->quads.push_back(sf::Vertex(transform.transformPoint(width, 0.f), color, sf::Vector2f(right, top)));
+	this->quads.push_back(sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom)));
+	this->quads.push_back(sf::Vertex(transform.transformPoint(0.f, height), color, sf::Vector2f(left, bottom)));
+}
+
+void SpriteBatch::add_vertices(const sf::VertexArray &vertices, const sf::Texture* texture, int layer) {
+	this->items.push_back(Item{ layer, texture, this->items.size(), 0, &vertices });
+}
+
+void SpriteBatch::flush(sf::RenderTarget &target) {
+	this->last_draw_calls = 0;
+	this->last_quad_count = this->quads.size() / 4;
+
+	// Sort
+	const bool sortByTexture = this->sort_by_texture;
+
+	std::sort(this->items.begin(), this->items.end(), [sortByTexture](const Item &lhs, const Item &rhs) {
+		if (lhs.layer != rhs.layer) return lhs.layer < rhs.layer;
+		if (sortByTexture && lhs.texture != rhs.texture) return std::less<const sf::Texture*>()(lhs.texture, rhs.texture);
+		return lhs.sequence < rhs.sequence;
+	});
+
+	// Submit texture runs
+	for (size_t i = 0; i < this->items.size();) {
+		const Item &first = this->items[i];
+
+		if (first.vertices) {
+			target.draw(*first.vertices, sf::RenderStates(first.texture));
+			++this->last_draw_calls;
+			++i;
+			continue;
+		}
+
+		this->run.clear();
+
+		for (; i < this->items.size() && !this->items[i].vertices && this->items[i].texture == first.texture; ++i) {
+			const auto quadBegin = this->quads.begin() + this->items[i].quad_index;
+			this->run.insert(this->run.end(), quadBegin, quadBegin + 4);
+		}
+
+		target.draw(this->run.data(), this->run.size(), sf::Quads, sf::RenderStates(first.texture));
+		++this->last_draw_calls;
+	}
+
+	this->clear();
+}
+
+void SpriteBatch::clear() {
+	this->items.clear();
+	this->quads.clear();
+}
+
+size_t SpriteBatch::draw_calls() const {
+	return this->last_draw_calls;
+}
+
+size_t SpriteBatch::quad_count() const {
+	return this->last_quad_count;
+}
@@ -0,0 +1,137 @@
+#include "graphics/texture_atlas.h"
+
+#include <algorithm> // 'sort()', 'min()', 'max()'
+#include <filesystem> // iterating over texture directories
+#include <iostream> // console output
+
+
+
+// # TextureRegion #
+void TextureRegion::apply(sf::Sprite &sprite) const {
+	sprite.setTexture(*this->texture);
+	sprite.setTextureRect(sf::IntRect(this->rect.x, this->rect.y, this->rect.w, this->rect.h));
+}
+
+sf::IntRect TextureRegion::subrect(const sf::IntRect &local) const {
+	return sf::IntRect(this->rect.x + local.left, this->rect.y + local.top, local.width, local.height);
+}
+
+srcRect TextureRegion::subrect(const srcRect &local) const {
+	return make_srcRect(this->rect.x + local.x, this->rect.y + local.y, local.w, local.h);
+}
+
+
+
+// # TextureAtlas #
+namespace TextureAtlas_consts {
+	constexpr unsigned int MAX_PAGE_SIZE = 2048; // safe for any GPU we care about
+	constexpr unsigned int PADDING = 1;
+}
+
+void TextureAtlas::pack(const std::vector<std::string> &directories) {
+	using namespace TextureAtlas_consts;
+
+	struct Entry {
+		std::string path;
+		sf::Image image;
+		unsigned int x = 0, y = 0;
+		size_t page = 0;
+	};
+
+	const unsigned int pageSize = std::min(MAX_PAGE_SIZE, sf::Texture::getMaximumSize());
+
+	// Collect images
+	std::vector<Entry> entries;
+
+	for (const auto &directory : directories) {
+		if (!std::filesystem::is_directory(directory)) continue;
+
+		for (const auto &file : std::filesystem::recursive_directory_iterator(directory)) {
+			if (!file.is_regular_file() || file.path().extension() != ".png") continue;
+
+			Entry entry;
+			entry.path = file.path().generic_string(); // same form as paths passed to 'Graphics::getTexture()'
+
+			if (!entry.image.loadFromFile(entry.path)) continue;
+
+			const auto size = entry.image.getSize();
+			if (size.x + PADDING > pageSize || size.y + PADDING > pageSize) continue; // left to be loaded as a standalone texture
+
+			entries.push_back(std::move(entry));
+		}
+	}
+
+	// Tallest first, path is used as a tie-breaker so layout doesn't depend on filesystem order
+	std::sort(entries.begin(), entries.end(), [](const Entry &lhs, const Entry &rhs) {
+		if (lhs.image.getSize().y != rhs.image.getSize().y) return lhs.image.getSize().y > rhs.image.getSize().y;
+		return lhs.path < rhs.path;
+	});
+
+	// Place images on shelves
+	std::vector<unsigned int> pageHeights; // used height of every page
+	unsigned int shelfX = 0, shelfY = 0, shelfHeight = 0;
+
+	for (auto &entry : entries) {
+		const auto size = entry.image.getSize();
+
+		if (pageHeights.empty()) pageHeights.push_back(0);
+
+		// Start a new shelf
+		if (shelfX + size.x + PADDING > pageSize) {
+			shelfX = 0;
+			shelfY += shelfHeight;
+			shelfHeight = 0;
+		}
+		// Start a new page
+		if (shelfY + size.y + PADDING > pageSize) {
+			pageHeights.push_back(0);
+			shelfX = 0;
+			shelfY = 0;
+			shelfHeight = 0;
+		}
+
+		entry.x = shelfX;
+		entry.y = shelfY;
+		entry.page = pageHeights.size() - 1;
+
+		shelfX += size.x + PADDING;
+		shelfHeight = std::max(shelfHeight, size.y + PADDING);
+		pageHeights.back() = std::max(pageHeights.back(), shelfY + shelfHeight);
+	}
+
+	// Compose pages (trimmed to used height) and upload them
+	std::vector<sf::Image> pageImages(pageHeights.size());
+
+	for (size_t i = 0; i < pageImages.size(); ++i) pageImages[i].create(pageSize, pageHeights[i], sf::Color::Transparent);
+
+	for (const auto &entry : entries) pageImages[entry.page].copy(entry.image, entry.x, entry.y);
+
+	std::vector<sf::Texture*> pageTextures;
+
+	for (const auto &pageImage : pageImages) {
+		this->pages.emplace_back();
+		this->pages.back().loadFromImage(pageImage);
+		pageTextures.push_back(&this->pages.back());
+	}
+
+	for (const auto &entry : entries) {
+		const auto size = entry.image.getSize();
+
+		this->regions[entry.path] = TextureRegion{
+			pageTextures[entry.page],
+			make_srcRect(entry.x, entry.y, size.x, size.y)
+		};
+	}
+
+	std::cout << "Packed " << entries.size() << " images into " << pageImages.size() << " atlas page(s)\n";
+}
+
+const TextureRegion* TextureAtlas::find(const std::string &filePath) const {
+	const auto iter = this->regions.find(filePath);
+
+	return (iter != this->regions.end()) ? &iter->second : nullptr;
+}
+
+size_t TextureAtlas::page_count() const {
+	return this->pages.size();
+}
@@ -0,0 +1,128 @@
+#include "graphics/tile_mesh.h"
+
+#include "graphics/graphics.h" // access to rendering
+#include "utility/globalconsts.hpp" // natural consts (tile size), performance consts (chunk size)
+
+
+
+// # TileMesh #
+void TileMesh::init(const Vector2 &mapSize) {
+	constexpr int chunkSize = performance::TILE_CHUNK_SIZE;
+
+	this->chunk_grid_size = Vector2(
+		(mapSize.x + chunkSize - 1) / chunkSize,
+		(mapSize.y + chunkSize - 1) / chunkSize
+	);
+
+	this->chunks.clear();
+	this->chunks.resize(this->chunk_grid_size.x * this->chunk_grid_size.y);
+}
+
+void TileMesh::add_tile(const Vector2 &index, const sf::Texture* texture, const srcRect &sourceRect, bool animated) {
+	auto &chunk = this->getChunk(Vector2(index.x / performance::TILE_CHUNK_SIZE, index.y / performance::TILE_CHUNK_SIZE));
+
+	size_t batchIndex;
+	auto &batch = this->getBatch(chunk, texture, batchIndex);
+
+	const size_t vertexIndex = batch.vertices.getVertexCount();
+	batch.vertices.resize(vertexIndex + 4);
+
+	// Set position (tiles are drawn with their native size, so it doesn't depend on source rect position)
+	const float left = static_cast<float>(index.x * natural::TILE_SIZE);
+	const float top = static_cast<float>(index.y * natural::TILE_SIZE);
+	const float right = left + static_cast<float>(sourceRect.w);
+	const float bottom = top + static_cast<float>(sourceRect.h);
+
+	sf::Vertex* quad = &batch.vertices[vertexIndex];
+
+	quad[0].position = sf::Vector2f(left, top);
+	quad[1].position = sf::Vector2f(right, top);
+	quad[2].position = sf::Vector2f(right, bottom);
+	quad[3].position = sf::Vector2f(left, bottom);
+
+	set_quad_texcoords(quad, sf::IntRect(sourceRect.x, sourceRect.y, sourceRect.w, sourceRect.h));
+
+	if (animated) chunk.animated_quads.push_back(AnimatedQuad{ batchIndex, vertexIndex, index, nullptr });
+}
+
+void TileMesh::bind_animated_sprite(const Vector2 &index, const Sprite* sprite) {
+	auto &chunk = this->getChunk(Vector2(index.x / performance::TILE_CHUNK_SIZE, index.y / performance::TILE_CHUNK_SIZE));
+
+	for (auto &animatedQuad : chunk.animated_quads)
+		if (animatedQuad.tile_index == index) animatedQuad.sprite = sprite;
+}
+
+void TileMesh::unbind_animated_sprites() {
+	for (auto &chunk : this->chunks)
+		for (auto &animatedQuad : chunk.animated_quads) animatedQuad.sprite = nullptr;
+}
+
+void TileMesh::draw(const Vector2 &cornerIndex, const Vector2 &endIndex) {
+	this->last_draw_calls = 0;
+
+	if (this->chunks.empty()) return;
+
+	constexpr int chunkSize = performance::TILE_CHUNK_SIZE;
+
+	const int leftBound = std::max(cornerIndex.x / chunkSize, 0);
+	const int rightBound = std::min(endIndex.x / chunkSize, this->chunk_grid_size.x - 1);
+	const int upperBound = std::max(cornerIndex.y / chunkSize, 0);
+	const int lowerBound = std::min(endIndex.y / chunkSize, this->chunk_grid_size.y - 1);
+
+	for (int X = leftBound; X <= rightBound; ++X)
+		for (int Y = upperBound; Y <= lowerBound; ++Y) {
+			auto &chunk = this->getChunk(Vector2(X, Y));
+
+			// Patch animated tiles
+			for (const auto &animatedQuad : chunk.animated_quads)
+				if (animatedQuad.sprite) set_quad_texcoords(
+					&chunk.batches[animatedQuad.batch_index].vertices[animatedQuad.vertex_index],
+					animatedQuad.sprite->getTextureRect()
+				);
+
+			// Draw
+			for (const auto &batch : chunk.batches) {
+				Graphics::ACCESS->camera->draw_vertices(batch.vertices, batch.texture);
+				++this->last_draw_calls;
+			}
+		}
+}
+
+size_t TileMesh::draw_calls() const {
+	return this->last_draw_calls;
+}
+
+size_t TileMesh::vertex_count() const {
+	size_t count = 0;
+
+	for (const auto &chunk : this->chunks)
+		for (const auto &batch : chunk.batches) count += batch.vertices.getVertexCount();
+
+	return count;
+}
+
+TileMesh::Chunk& TileMesh::getChunk(const Vector2 &chunkIndex) {
+	return this->chunks[chunkIndex.x * this->chunk_grid_size.y + chunkIndex.y];
+}
+
+TileMesh::Batch& TileMesh::getBatch(Chunk &chunk, const sf::Texture* texture, size_t &batchIndex) {
+	// Levels rarely use more than a few tilesets, linear search is fine
+	for (batchIndex = 0; batchIndex < chunk.batches.size(); ++batchIndex)
+		if (chunk.batches[batchIndex].texture == texture) return chunk.batches[batchIndex];
+
+	chunk.batches.push_back(Batch{ texture, sf::VertexArray(sf::Quads) });
+
+	return chunk.batches.back();
+}
+
+void TileMesh::set_quad_texcoords(sf::Vertex* quad, const sf::IntRect &rect) {
+	const float left = static_cast<float>(rect.left);
+	const float top = static_cast<float>(rect.top);
+	const float right = left + static_cast<float>(rect.width);
+	const float bottom = top + static_cast<float>(rect.height);
+
+	quad[0].texCoords = sf::Vector2f(left, top);
+	quad[1].texCoords = sf::Vector2f(right, top);
+	quad[2].texCoords = sf::Vector2f(right, bottom);
+	quad[3].texCoords = sf::Vector2f(left, bottom);
+}
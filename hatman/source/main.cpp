@@ -3,18 +3,23 @@
 // NOTE: CORRESPONDING HEADER
 
 // Includes: std
+#include <cstdint>  // fixed-size seed
 #include <ctime>    // used to generate seed for random
 #include <iostream> // Text to console TEMP:
+#include <memory>   // 'unique_ptr' for optional recorder
+#include <string>   // parsing arguments
 
 // Includes: dependencies
 
 // Includes: project
 #include "graphics/graphics.h"   // Has a storage (initialized before start)
+#include "modules/sprite.h"      // Has a storage (initialized before start)
 #include "objects/tile_base.h"   // Has a storage (initialized before start)
 #include "systems/audio.h"       // Has a storage (initialized before start)
 #include "systems/controls.h"    // Has a storage (initialized before start)
 #include "systems/emit.h"        // Has a storage (initialized before start)
 #include "systems/game.h"        // 'Game' class
+#include "systems/replay.h"      // 'InputRecorder' class
 #include "systems/saver.h"       // Has a storage (initialized before start)
 #include "systems/timer.h"       // Has a storage (initialized before start)
 #include "utility/launch_info.h" // 'LaunchInfo' class
@@ -23,8 +28,16 @@
 
 
 
-int main() {
-    std::srand(static_cast<int>(std::time(nullptr))); // TODO: Remove this nonsense
+// Usage: 'main [--record <file>]'
+// - '--record' writes input of the first session to a replay file, see 'hatman_headless' for playback
+
+int main(int argc, char* argv[]) {
+    std::string record_filepath;
+
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--record") record_filepath = argv[++i];
+
+    const auto seed = static_cast<std::uint32_t>(std::time(nullptr)); // same seed is kept across restarts
 
     std::cout << "- Execution log -" << std::endl;
 
@@ -57,6 +70,7 @@ int main() {
         Graphics        graphics(resolution_x, resolution_y, convert_string_to_window_flags(screen_mode));
         Audio           audio(music, sound);
         TilesetStorage  tilesets;
+        AnimationStorage animations;
         EmitStorage     emits;
         Flags           flags;
         Saver           saver(save_filepath);
@@ -65,9 +79,24 @@ int main() {
         // from now on all these objects can be accessed through 'ClassName::ACCESS' / 'ClassName::READ'
         // anywhere that has their header included
 
+        game.rng_seed = seed;
+
+        // Record input (restarts aren't recorded since replay can't reproduce them)
+        std::unique_ptr<InputRecorder> recorder;
+
+        if (!record_filepath.empty()) {
+            recorder = std::make_unique<InputRecorder>(record_filepath, seed, save_filepath);
+
+            if (recorder->is_open()) game.input_recorder = recorder.get();
+            else std::cout << "Error: Could not open replay file '" << record_filepath << "' for writing.\n";
+
+            record_filepath.clear();
+        }
+
         // Start the main loop
         exit_code = game.game_loop();
 
+        if (recorder) std::cout << "Recorded steps: " << recorder->step_count() << "\n";
         std::cout << "Exit code: " << static_cast<int>(exit_code) << "\n";
     }
 }
@@ -0,0 +1,168 @@
+// _______________________ INCLUDES _______________________
+
+// NOTE: CORRESPONDING HEADER
+
+// Includes: std
+#include <algorithm> // 'max()'
+#include <chrono>    // measuring simulation time
+#include <cstdint>   // fixed-size seed
+#include <iostream>  // Text to console
+#include <string>    // parsing arguments
+
+// Includes: dependencies
+
+// Includes: project
+#include "graphics/graphics.h"      // Has a storage (initialized before start)
+#include "modules/sprite.h"         // Has a storage (initialized before start)
+#include "objects/tile_base.h"      // Has a storage (initialized before start)
+#include "systems/audio.h"          // Has a storage (initialized before start)
+#include "systems/controls.h"       // Has a storage (initialized before start)
+#include "systems/emit.h"           // Has a storage (initialized before start)
+#include "systems/game.h"           // 'Game' class
+#include "systems/replay.h"         // 'InputReplay' class
+#include "systems/saver.h"          // Has a storage (initialized before start)
+#include "systems/timer.h"          // Has a storage (initialized before start)
+#include "utility/globalconsts.hpp" // natural resolution, timestep
+
+// ____________________ IMPLEMENTATION ____________________
+
+
+
+// Headless runner
+// - Usage: 'hatman_headless [frames]' or 'hatman_headless --replay <file>'
+// - Loads level from the save selected in 'CONFIG.json' (new save is created if there is none)
+//   and runs the simulation with no window and no audio device
+// - Prints pure update cost, useful for soak-testing levels
+// - In replay mode save snapshot and seed are restored from the replay file
+//   and game is run from main menu until the replay ends
+// - Replay also verifies recorded state checksums, so replaying a recording of the main build ('main --record <file>')
+//   checks that both builds simulate identically, exits with 1 if they diverged,
+//   sound-gated erases (picked up items, exploded projectiles) are part of the checksum and counted in the summary
+
+constexpr size_t DEFAULT_FRAMES = 10000;
+constexpr size_t MAX_LOAD_FRAMES = 1000; // level loads after transition fade, which is simulated as well
+constexpr std::uint32_t SEED = 0; // fixed seed so runs are repeatable
+
+const std::string REPLAY_SAVE_FILEPATH = "replay_save.json"; // replays don't touch the real save
+
+int replay(const std::string &replay_filepath) {
+    InputReplay input_replay(replay_filepath);
+
+    if (!input_replay.is_open()) {
+        std::cout << "Error: Could not read replay file '" << replay_filepath << "'.\n";
+        return -1;
+    }
+
+    input_replay.write_save(REPLAY_SAVE_FILEPATH);
+
+    // Initialize all the storage objects (with null graphics and audio backends)
+    TimerController  timerController; // [!] timers must be created first
+    Graphics         graphics(natural::WIDTH, natural::HEIGHT, sf::Style::None);
+    Audio            audio(0, 0);
+    TilesetStorage   tilesets;
+    AnimationStorage animations;
+    EmitStorage      emits;
+    Flags            flags;
+    Saver            saver(REPLAY_SAVE_FILEPATH);
+    Controls         controls;
+    Game             game(false);
+
+    game.rng_seed = input_replay.seed();
+    game.input_replay = &input_replay;
+
+    // Simulate until the replay ends
+    size_t frames = 0;
+    ExitCode exit_code = ExitCode::NONE;
+
+    const auto start = std::chrono::steady_clock::now();
+    while (exit_code == ExitCode::NONE && !input_replay.finished()) {
+        exit_code = game.run_frames(1);
+        ++frames;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double total_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout
+        << "- Headless replay -\n"
+        << "Replay:            " << replay_filepath << "\n"
+        << "Level:             " << (game.is_running() ? game.level->getName() : "<none>") << "\n"
+        << "Frames:            " << frames << "\n"
+        << "Delayed erases:    " << (game.is_running() ? game.level->delayed_erase_count : 0) << " (on the last level)\n"
+        << "Checksums:         " << input_replay.checksums_verified() << " verified\n"
+        << "Total time:        " << total_ms << " ms\n"
+        << "Exit code:         " << static_cast<int>(exit_code) << "\n";
+
+    if (input_replay.diverged()) {
+        std::cout << "Error: Replay diverged from the recording at step " << input_replay.first_divergent_step() << ".\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2 && std::string(argv[1]) == "--replay") return replay(argv[2]);
+
+    const size_t frames = (argc > 1) ? std::stoull(argv[1]) : DEFAULT_FRAMES;
+
+    // Parse launch params from 'CONFIG.json', only the save path matters
+    int         resolution_x;
+    int         resolution_y;
+    std::string screen_mode;
+    int         music;
+    int         sound;
+    bool        fps_counter;
+    std::string save_filepath;
+
+    if (!config_parse(resolution_x, resolution_y, screen_mode, music, sound, fps_counter, save_filepath)) {
+        config_create_default();
+        if (!config_parse(resolution_x, resolution_y, screen_mode, music, sound, fps_counter, save_filepath)) {
+            std::cout << "Error: Could not read default config.";
+            return -1;
+        }
+    }
+
+    // Initialize all the storage objects (with null graphics and audio backends)
+    TimerController  timerController; // [!] timers must be created first
+    Graphics         graphics(natural::WIDTH, natural::HEIGHT, sf::Style::None);
+    Audio            audio(0, 0);
+    TilesetStorage   tilesets;
+    AnimationStorage animations;
+    EmitStorage      emits;
+    Flags            flags;
+    Saver            saver(save_filepath);
+    Controls         controls;
+    Game             game(false);
+
+    game.rng_seed = SEED;
+
+    // Load level
+    if (!saver.save_present()) saver.create_new();
+
+    game.request_levelLoadFromSave();
+
+    for (size_t i = 0; i < MAX_LOAD_FRAMES && !game.is_running(); ++i) game.run_frames(1);
+
+    if (!game.is_running()) {
+        std::cout << "Error: Level didn't load in " << MAX_LOAD_FRAMES << " frames.\n";
+        return -1;
+    }
+
+    // Simulate
+    const auto start = std::chrono::steady_clock::now();
+    const ExitCode exit_code = game.run_frames(frames);
+    const auto end = std::chrono::steady_clock::now();
+
+    const double total_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout
+        << "- Headless run -\n"
+        << "Level:             " << (game.is_running() ? game.level->getName() : "<none>") << "\n"
+        << "Frames:            " << frames << " (" << frames * performance::FIXED_TIMESTEP_MS / 1000. << " s of game time)\n"
+        << "Entities:          " << (game.is_running() ? game.level->entities.size() : 0) << "\n"
+        << "Total time:        " << total_ms << " ms\n"
+        << "Time per frame:    " << total_ms * 1000. / std::max<size_t>(frames, 1) << " us\n"
+        << "Frames per second: " << frames / (total_ms / 1000.) << "\n"
+        << "Exit code:         " << static_cast<int>(exit_code) << "\n";
+}
@@ -1,5 +1,8 @@
 #include "modules/solid.h"
 
+#include <cmath> // 'abs()'
+#include <limits> // 'infinity()'
+
 #include "systems/game.h" // access to timescale and game state
 #include "utility/globalconsts.hpp" // contains tile size (used in tile collision detection)
 #include "objects/tile_base.h" // 'Tile' type
@@ -8,6 +11,57 @@
 
 
 // # Entity::Physics #
+namespace SolidRectangle_consts {
+	constexpr double SWEEP_THRESHOLD = 4.;
+		// movement (per step, in pixels) above which tile collisions are swept before overlap resolution,
+		// slower solids can't skip over any tile rect so they don't need it
+	constexpr double SWEEP_SKIN = 0.01;
+		// swept movement goes that far past the contact, so overlap resolution still sees the collision
+
+	constexpr int SLEEP_STEPS = 30; // solid falls asleep after resting for that many steps in a row
+	constexpr double SLEEP_SPEED = 1.; // speed (in pixels per second) below which solid counts as still
+}
+
+// Time of impact of 'rect' moved by 'movement' against a static 'obstacle' (slab test), 1 if they don't meet
+static double sweep_rect(const dRect &rect, const Vector2d &movement, const dRect &obstacle, Vector2d &normal) {
+	constexpr double INF = std::numeric_limits<double>::infinity();
+
+	double enterX = -INF, exitX = INF;
+	if (movement.x > 0.) {
+		enterX = (obstacle.getLeft() - rect.getRight()) / movement.x;
+		exitX = (obstacle.getRight() - rect.getLeft()) / movement.x;
+	}
+	else if (movement.x < 0.) {
+		enterX = (obstacle.getRight() - rect.getLeft()) / movement.x;
+		exitX = (obstacle.getLeft() - rect.getRight()) / movement.x;
+	}
+	else if (rect.getRight() <= obstacle.getLeft() || obstacle.getRight() <= rect.getLeft()) {
+		return 1.;
+	}
+
+	double enterY = -INF, exitY = INF;
+	if (movement.y > 0.) {
+		enterY = (obstacle.getTop() - rect.getBottom()) / movement.y;
+		exitY = (obstacle.getBottom() - rect.getTop()) / movement.y;
+	}
+	else if (movement.y < 0.) {
+		enterY = (obstacle.getBottom() - rect.getTop()) / movement.y;
+		exitY = (obstacle.getTop() - rect.getBottom()) / movement.y;
+	}
+	else if (rect.getBottom() <= obstacle.getTop() || obstacle.getBottom() <= rect.getTop()) {
+		return 1.;
+	}
+
+	const double enter = std::max(enterX, enterY);
+	const double exit = std::min(exitX, exitY);
+
+	if (enter >= exit || enter < 0. || enter >= 1.) return 1.; // no contact, already overlapping or contact past the movement
+
+	normal = (enterX > enterY) ? Vector2d(-helpers::sign(movement.x), 0.) : Vector2d(0., -helpers::sign(movement.y));
+
+	return enter;
+}
+
 SolidRectangle::SolidRectangle(Vector2d &parentPosition, const Vector2d &hitboxSize, SolidFlags flags, double mass = 1, double friction = 0) :
 	parent_position(parentPosition),
 	hitboxSize(hitboxSize),
@@ -20,13 +74,26 @@ SolidRectangle::SolidRectangle(Vector2d &parentPosition, const Vector2d &hitboxS
 	enabled(true),
 	is_grounded(false),
 	is_dropping_down(false),
+	is_sleeping(false),
 	total_force(0., 0.),
-	friction_compensated(false)
+	friction_compensated(false),
+	resting_steps(0)
 {}
 
 void SolidRectangle::update(Milliseconds elapsedTime) {
 	if (!this->enabled) return;
 
+	// Sleeping solids only check if something disturbed them
+	if (this->is_sleeping) {
+		if (!this->_isDisturbed()) {
+			this->total_force = Vector2d();
+			this->friction_compensated = false;
+			return;
+		}
+
+		this->wake();
+	}
+
 	bool nonFrictionalHorizontalForcePresent = static_cast<bool>(this->total_force.x);
 
 	// Apply gravity
@@ -60,11 +127,21 @@ void SolidRectangle::update(Milliseconds elapsedTime) {
 	this->movement = this->speed * ms_to_sec(elapsedTime) + this->acceleration * ms_to_sec(elapsedTime) * ms_to_sec(elapsedTime) * 0.5;
 
 	// Apply interaction with objects that may affect .movement
-	if (this->flags & SolidFlags::SOLID) this->apply_TileCollisions();
+	if (this->flags & SolidFlags::SOLID) {
+		this->apply_SweptTileCollisions();
+		this->apply_TileCollisions();
+	}
 	this->apply_LevelBorderCollisions();
 
 	// Set final position
 	this->parent_position += this->movement;
+
+	this->_updateSleep();
+}
+
+void SolidRectangle::wake() {
+	this->is_sleeping = false;
+	this->resting_steps = 0;
 }
 
 // Checks/getters
@@ -72,7 +149,7 @@ dRect SolidRectangle::getHitbox() const {
 	return dRect(parent_position, this->hitboxSize, true);
 }
 
-Tile* SolidRectangle::getFirstCollision_Tile() const {
+bool SolidRectangle::hasCollision_Tile() const {
 	const dRect entityRect = this->getHitbox();
 
 	const Vector2 centerIndex = helpers::divide32(this->parent_position);
@@ -86,26 +163,66 @@ Tile* SolidRectangle::getFirstCollision_Tile() const {
 
 	for (int X = leftBound; X <= rightBound; ++X)
 		for (int Y = upperBound; Y <= lowerBound; ++Y) {
-			const auto tile = Game::ACCESS->level->getTile(X, Y);
+			bool collision = false;
 
 			// Go over tile hitbox rects and check for collisions
-			if (tile && tile->hitbox)
-				for (const auto hitboxRect : tile->hitbox->rectangles)
-					if (entityRect.overlapsWithRect(hitboxRect.rect))
-						return tile;
+			Game::READ->level->collision_grid.for_each_rect(X, Y, [&](const TileHitboxRect &hitboxRect) {
+				if (entityRect.overlapsWithRect(hitboxRect.rect)) collision = true;
+			});
+
+			if (collision) return true;
 		}
 
-	return nullptr;
+	return false;
+}
+
+TileSweep SolidRectangle::sweep_Tiles(const Vector2d &movement) const {
+	return this->sweep_Tiles(this->getHitbox(), movement);
+}
+
+TileSweep SolidRectangle::sweep_Tiles(const dRect &hitbox, const Vector2d &movement) const {
+	TileSweep result;
+
+	if (movement.x == 0. && movement.y == 0.) return result;
+
+	const auto &level = Game::READ->level;
+
+	// Cells covered by the hitbox on its whole way
+	const int leftBound = std::max(helpers::divide32(std::min(hitbox.getLeft(), hitbox.getLeft() + movement.x)), 0);
+	const int rightBound = std::min(helpers::divide32(std::max(hitbox.getRight(), hitbox.getRight() + movement.x)), level->getSizeX() - 1);
+	const int upperBound = std::max(helpers::divide32(std::min(hitbox.getTop(), hitbox.getTop() + movement.y)), 0);
+	const int lowerBound = std::min(helpers::divide32(std::max(hitbox.getBottom(), hitbox.getBottom() + movement.y)), level->getSizeY() - 1);
+
+	const bool platformsStopMovement = movement.y > 0. && !this->is_dropping_down;
+
+	for (int X = leftBound; X <= rightBound; ++X)
+		for (int Y = upperBound; Y <= lowerBound; ++Y)
+			level->collision_grid.for_each_rect(X, Y, [&](const TileHitboxRect &hitboxRect) {
+				if (hitboxRect.is_platform && !platformsStopMovement) return;
+
+				Vector2d normal;
+				const double time = sweep_rect(hitbox, movement, hitboxRect.rect, normal);
+
+				if (time >= result.time_of_impact) return;
+				if (hitboxRect.is_platform && normal.y >= 0.) return; // platforms are only landed on from above
+
+				result.time_of_impact = time;
+				result.normal = normal;
+			});
+
+	return result;
 }
 
 ntt::Entity* SolidRectangle::getFirstCollision_DifferentFactionEntity(Faction faction) const {
 	const dRect entityRect = this->getHitbox();
 
-	for (auto &otherEntity : Game::ACCESS->level->entities_killable)
-		if (otherEntity->health->faction != faction && entityRect.overlapsWithRect(otherEntity->solid->getHitbox()))
-			return otherEntity;
-	
-	return nullptr;
+	ntt::Entity* firstCollision = nullptr;
+
+	Game::ACCESS->level->entities_grid.for_each_in_rect(entityRect, [&](ntt::Entity* otherEntity) {
+		if (!firstCollision && otherEntity->health->faction != faction) firstCollision = otherEntity;
+	});
+
+	return firstCollision;
 }
 
 // Force
@@ -242,15 +359,13 @@ void SolidRectangle::apply_TileCollisions() {
 
 		for (int X = leftBound; X <= rightBound; ++X)
 			for (int Y = upperBound; Y <= lowerBound; ++Y) {
-				const auto tile = Game::ACCESS->level->getTile(X, Y);
-
 				// Go over tile hitbox rects and check for collisions
-				if (tile && tile->hitbox)
-					for (const auto hitboxRect : tile->hitbox->rectangles)
-						if (entityRect.overlapsWithRect(hitboxRect.rect) && !hitboxRect.is_platform) {
-							entityRect.moveRightTo(hitboxRect.rect.getLeft());
-							this->speed.x = 0.;
-						}
+				Game::READ->level->collision_grid.for_each_solid_rect(X, Y, [&](const TileHitboxRect &hitboxRect) {
+					if (entityRect.overlapsWithRect(hitboxRect.rect)) {
+						entityRect.moveRightTo(hitboxRect.rect.getLeft());
+						this->speed.x = 0.;
+					}
+				});
 			}
 	}
 	// Collisions happens at LEFT => iterate over 6 (or more for big solids) tiles at left
@@ -262,15 +377,13 @@ void SolidRectangle::apply_TileCollisions() {
 
 		for (int X = leftBound; X <= rightBound; ++X)
 			for (int Y = upperBound; Y <= lowerBound; ++Y) {
-				const auto tile = Game::ACCESS->level->getTile(X, Y);
-
 				// Go over tile hitbox rects and check for collisions
-				if (tile && tile->hitbox)
-					for (const auto hitboxRect : tile->hitbox->rectangles)
-						if (entityRect.overlapsWithRect(hitboxRect.rect) && !hitboxRect.is_platform) {
-							entityRect.moveLeftTo(hitboxRect.rect.getRight());
-							this->speed.x = 0.;
-						}
+				Game::READ->level->collision_grid.for_each_solid_rect(X, Y, [&](const TileHitboxRect &hitboxRect) {
+					if (entityRect.overlapsWithRect(hitboxRect.rect)) {
+						entityRect.moveLeftTo(hitboxRect.rect.getRight());
+						this->speed.x = 0.;
+					}
+				});
 			}
 	}
 
@@ -286,38 +399,35 @@ void SolidRectangle::apply_TileCollisions() {
 
 		for (int X = leftBound; X <= rightBound; ++X)
 			for (int Y = upperBound; Y <= lowerBound; ++Y) {
-				const auto tile = Game::ACCESS->level->getTile(X, Y);
-
 				// Go over tile hitbox rects and check for collisions
-				if (tile && tile->hitbox)
-					for (const auto hitboxRect : tile->hitbox->rectangles) {
-						// Handle collision with rect
-						if (entityRect.overlapsWithRect(hitboxRect.rect)) {
-							// regular collision
-							if (!hitboxRect.is_platform) { 
-								entityRect.moveBottomTo(hitboxRect.rect.getTop());
-								this->speed.y = 0.;
-								this->is_grounded = true;
-							}
-                            // collision with platform, condition may need fine-tuning
-							else if (entityRect.getBottom() < hitboxRect.rect.getTop() + physics::PLATFORM_EPSILON && !this->is_dropping_down) {
-								entityRect.moveBottomTo(hitboxRect.rect.getTop());
-								this->speed.y = 0.;
-								this->is_grounded = true;
-							}
-                        }
-
-						// Deduce whether left/right sides are grounded
-						if (this->is_grounded) {
-							if (hitboxRect.rect.getLeft() < entityRect.getLeft())
-								this->is_grounded_at_left = true;
-
-							if (hitboxRect.rect.getRight() > entityRect.getRight())
-								this->is_grounded_at_right = true;
-								// logic can be simplified to this since we already know that collision happened
-								// and it happened precisely at the bottom
+				Game::READ->level->collision_grid.for_each_rect(X, Y, [&](const TileHitboxRect &hitboxRect) {
+					// Handle collision with rect
+					if (entityRect.overlapsWithRect(hitboxRect.rect)) {
+						// regular collision
+						if (!hitboxRect.is_platform) { 
+							entityRect.moveBottomTo(hitboxRect.rect.getTop());
+							this->speed.y = 0.;
+							this->is_grounded = true;
+						}
+						// collision with platform, condition may need fine-tuning
+						else if (entityRect.getBottom() < hitboxRect.rect.getTop() + physics::PLATFORM_EPSILON && !this->is_dropping_down) {
+							entityRect.moveBottomTo(hitboxRect.rect.getTop());
+							this->speed.y = 0.;
+							this->is_grounded = true;
 						}
 					}
+
+					// Deduce whether left/right sides are grounded
+					if (this->is_grounded) {
+						if (hitboxRect.rect.getLeft() < entityRect.getLeft())
+							this->is_grounded_at_left = true;
+
+						if (hitboxRect.rect.getRight() > entityRect.getRight())
+							this->is_grounded_at_right = true;
+							// logic can be simplified to this since we already know that collision happened
+							// and it happened precisely at the bottom
+					}
+				});
 			}
 	}
 	// Collisions happens at TOP => iterate over 6 (or more for big solids) tiles at top
@@ -329,21 +439,68 @@ void SolidRectangle::apply_TileCollisions() {
 
 		for (int X = leftBound; X <= rightBound; ++X)
 			for (int Y = upperBound; Y <= lowerBound; ++Y) {
-				const auto tile = Game::ACCESS->level->getTile(X, Y);
-
 				// Go over tile hitbox rects and check for collisions
-				if (tile && tile->hitbox)
-					for (const auto hitboxRect : tile->hitbox->rectangles)
-						if (!hitboxRect.is_platform && entityRect.overlapsWithRect(hitboxRect.rect)) {
-							entityRect.moveTopTo(hitboxRect.rect.getBottom());
-							this->speed.y = 0.;
-						}
+				Game::READ->level->collision_grid.for_each_solid_rect(X, Y, [&](const TileHitboxRect &hitboxRect) {
+					if (entityRect.overlapsWithRect(hitboxRect.rect)) {
+						entityRect.moveTopTo(hitboxRect.rect.getBottom());
+						this->speed.y = 0.;
+					}
+				});
 			}
 	}
 
 	this->movement = entityRect.getCenter() - this->parent_position;
 }
 
+void SolidRectangle::apply_SweptTileCollisions() {
+	using namespace SolidRectangle_consts;
+
+	// Overlap resolution only checks where the solid ends up, so fast solids could jump over thin tiles,
+	// their movement is cut just past the first obstacle on each axis and then resolved as usual
+	const auto cut_movement = [](double &movement, const TileSweep &sweep) {
+		if (!sweep.hit()) return;
+
+		const double cutMovement = movement * sweep.time_of_impact + helpers::sign(movement) * SWEEP_SKIN;
+		if (std::abs(cutMovement) < std::abs(movement)) movement = cutMovement;
+	};
+
+	dRect entityRect = this->getHitbox();
+
+	if (std::abs(this->movement.x) > SWEEP_THRESHOLD)
+		cut_movement(this->movement.x, this->sweep_Tiles(entityRect, Vector2d(this->movement.x, 0.)));
+
+	entityRect.moveByX(this->movement.x);
+
+	if (std::abs(this->movement.y) > SWEEP_THRESHOLD)
+		cut_movement(this->movement.y, this->sweep_Tiles(entityRect, Vector2d(0., this->movement.y)));
+}
+
+bool SolidRectangle::_isDisturbed() const {
+	return
+		this->total_force != Vector2d() || // gravity is applied during update, so it doesn't count
+		this->speed != Vector2d() || // impulses and direct speed changes
+		this->parent_position != this->sleep_position || // teleports and other external movement
+		!this->is_grounded || this->is_dropping_down; // jumps and dropping through platforms
+}
+
+void SolidRectangle::_updateSleep() {
+	using namespace SolidRectangle_consts;
+
+	const bool isResting =
+		this->is_grounded && !this->is_dropping_down &&
+		std::abs(this->speed.x) < SLEEP_SPEED && std::abs(this->speed.y) < SLEEP_SPEED;
+
+	this->resting_steps = isResting ? this->resting_steps + 1 : 0;
+
+	if (this->resting_steps < SLEEP_STEPS) return;
+
+	this->is_sleeping = true;
+	this->speed = Vector2d();
+	this->acceleration = Vector2d();
+	this->movement = Vector2d();
+	this->sleep_position = this->parent_position;
+}
+
 void SolidRectangle::apply_LevelBorderCollisions() {
 	const dRect entityHitbox = this->getHitbox();
 	const double levelWidth = Game::READ->level->getSize().x * natural::TILE_SIZE; // Assumes rendering size is equal to physica;
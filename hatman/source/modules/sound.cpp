@@ -4,7 +4,14 @@
 #include "utility/globalconsts.hpp" // holds base volume
 #include "systems/audio.h" // sound loading
 
-Sound::Sound(const std::string &name, double volumeMod) {
+constexpr Milliseconds _epsilon = 1e-3;
+// we slightly overestimate duration just in case,
+// don't want to cut the last tiny portion of the sound
+
+#ifndef HATMAN_HEADLESS
+Sound::Sound(const std::string &name, double volumeMod) :
+	duration(Audio::ACCESS->getSoundDuration(name))
+{
 	this->sound.setBuffer(Audio::ACCESS->getSoundBuffer(name));
 
 	constexpr double SFML_MAX_VOLUME = 100; // SFML uses volume range [0, 100]
@@ -15,22 +22,24 @@ Sound::Sound(const std::string &name, double volumeMod) {
 
 void Sound::play() {
 	this->sound.play();
+	this->playback.start(this->duration);
 }
+#else
+Sound::Sound(const std::string &name, [[maybe_unused]] double volumeMod) :
+	duration(Audio::ACCESS->getSoundDuration(name))
+{}
 
-constexpr Milliseconds _epsilon = 1e-3;
-// we slightly overestimate duration just in case,
-// don't want to cut the last tiny portion of the sound
+void Sound::play() {
+	this->playback.start(this->duration);
+}
+#endif
 
 Milliseconds Sound::get_duration() const {
-	sf::Time sfml_duration = this->sound.getBuffer()->getDuration();
-	Milliseconds duration = sfml_duration.asMicroseconds() / 1e3;
-	return duration + _epsilon;
+	return this->duration + _epsilon;
 }
 
 Milliseconds Sound::get_remaining_duration() const {
-	sf::Time sfml_offset = this->sound.getPlayingOffset();
-	sf::Time sfml_duration = this->sound.getBuffer()->getDuration();
-	sf::Time sfml_remaining_duration = sfml_duration - sfml_offset;
-	Milliseconds remaining_duration = sfml_remaining_duration.asMicroseconds() / 1e3;
-	return remaining_duration + _epsilon;
-}
\ No newline at end of file
+	// Sound that isn't playing reports its full duration (same as SFML does)
+	const Milliseconds offset = this->playback.finished() ? 0. : this->playback.elapsed();
+	return this->duration - offset + _epsilon;
+}
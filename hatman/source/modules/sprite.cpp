@@ -1,5 +1,8 @@
 #include "modules/sprite.h"
 
+#include <fstream> // parsing from JSON (opening a file)
+#include "thirdparty/nlohmann.hpp" // parsing JSON
+
 #include "graphics/graphics.h" // access to rendering
 #include "systems/game.h" // access to timescale
 
@@ -8,30 +11,83 @@
 // # Animation #
 Animation::Animation(sf::Texture &texture, const std::vector<AnimationFrame> &frames) :
 	texture(&texture),
-	frames(frames)
+	frames(std::make_shared<const std::vector<AnimationFrame>>(frames))
 {}
 
 Animation::Animation(sf::Texture &texture, std::vector<AnimationFrame> &&frames) :
 	texture(&texture),
-	frames(std::move(frames))
+	frames(std::make_shared<const std::vector<AnimationFrame>>(std::move(frames)))
 {}
 
 Animation::Animation(sf::Texture &texture, std::initializer_list<AnimationFrame> frames) :
 	texture(&texture),
-	frames(frames)
+	frames(std::make_shared<const std::vector<AnimationFrame>>(frames))
 {}
 
 Animation::Animation(sf::Texture &texture, const srcRect &frame) :
 	texture(&texture),
-	frames({ AnimationFrame{frame, 0} })
+	frames(std::make_shared<const std::vector<AnimationFrame>>(1, AnimationFrame{ frame, 0 }))
 {}
 
 bool Animation::isSingleFrame() const {
-	return (this->frames.size() == 1);
+	return (this->frames->size() == 1);
 }
 
 size_t Animation::lastIndex() const {
-	return this->frames.size() - 1;
+	return this->frames->size() - 1;
+}
+
+const AnimationFrame& Animation::frame(size_t index) const {
+	return (*this->frames)[index];
+}
+
+const std::vector<AnimationFrame>& Animation::getFrames() const {
+	return *this->frames;
+}
+
+
+
+// # AnimationStorage #
+const AnimationStorage* AnimationStorage::READ;
+AnimationStorage* AnimationStorage::ACCESS;
+
+AnimationStorage::AnimationStorage() {
+	this->READ = this;
+	this->ACCESS = this;
+}
+
+Animation AnimationStorage::getAnimation(const std::string &path) {
+	auto iter = this->loadedAnimations.find(path);
+
+	if (iter == this->loadedAnimations.end()) { // animation is not loaded => load it
+		iter = this->loadedAnimations.emplace(path, this->parseFromJSON(path)).first;
+	}
+
+	return iter->second;
+}
+
+Animation AnimationStorage::parseFromJSON(const std::string &path) const {
+	std::ifstream ifStream(path + ".json");
+	nlohmann::json JSON = nlohmann::json::parse(ifStream);
+
+	// Parse texture (frames are stored relative to the image, so they have to be moved to its place in the atlas)
+	const auto region = Graphics::ACCESS->getTextureRegion(path + ".png");
+
+	// Parse frames
+	std::vector<AnimationFrame> frames;
+
+	for (const auto &node : JSON["frames"]) {
+		frames.push_back(AnimationFrame{
+			region.subrect(make_srcRect(
+				node["frame"]["x"].get<int>(),
+				node["frame"]["y"].get<int>(),
+				node["frame"]["w"].get<int>(),
+				node["frame"]["h"].get<int>())),
+			node["duration"].get<double>()
+			});
+	}
+
+	return Animation(*region.texture, std::move(frames));
 }
 
 
@@ -96,6 +152,10 @@ void Sprite::setRotationDegrees(double degrees) {
 	this->angle = degrees;
 }
 
+const sf::IntRect& Sprite::getTextureRect() const {
+	return this->current_sprite.getTextureRect();
+}
+
 
 
 // # StaticSprite #
@@ -143,18 +203,25 @@ AnimatedSprite::AnimatedSprite(
 	frame_index(0)
 {
 	this->current_sprite.setTexture(*this->animation.texture);
+
+	const auto &rect = this->animation.frame(0).rect;
+
+	this->current_sprite.setTextureRect(sf::IntRect(
+		rect.x, rect.y,
+		rect.w, rect.h
+	)); // otherwise whole texture would be displayed until the first update
 }
 
 void AnimatedSprite::update(Milliseconds elapsedTime) {
 	if (!animation.isSingleFrame()) {
 		this->time_elapsed += elapsedTime;
 
-		const Milliseconds timeBeforeUpdate = animation.frames.at(this->frame_index).duration; // time current animation frame is supposed to be displayed
+		const Milliseconds timeBeforeUpdate = animation.frame(this->frame_index).duration; // time current animation frame is supposed to be displayed
 
 		if (this->time_elapsed > timeBeforeUpdate) {
 			this->time_elapsed = 0.;
 
-			if (this->frame_index < animation.frames.size() - 1) { // if current frame is not the last
+			if (this->frame_index < animation.lastIndex()) { // if current frame is not the last
 				++this->frame_index;
 			}
 			else { // if current frame is the last
@@ -163,7 +230,7 @@ void AnimatedSprite::update(Milliseconds elapsedTime) {
 		}
 	}
 
-	const auto &rect = this->animation.frames.at(this->frame_index).rect;
+	const auto &rect = this->animation.frame(this->frame_index).rect;
 
 	this->current_sprite.setTextureRect(sf::IntRect(
 		rect.x, rect.y,
@@ -205,7 +272,7 @@ void ControllableSprite::animation_play(const std::string &name, bool loop) {
 
 	this->current_sprite.setTexture(*this->animation_current->texture);
 
-	const auto &rect = this->animation_current->frames.front().rect;
+	const auto &rect = this->animation_current->frame(0).rect;
 
 	this->current_sprite.setTextureRect(sf::IntRect(
 		rect.x, rect.y,
@@ -237,7 +304,7 @@ bool ControllableSprite::animation_finished() const {
 Milliseconds ControllableSprite::animation_duration(const std::string &name) const {
 	Milliseconds total = 0.;
 
-	for (const auto& frame : this->animations.at(name).frames) {
+	for (const auto& frame : this->animations.at(name).getFrames()) {
 		total += frame.duration; /// Consider imbedding duration in animation itself
 	}
 
@@ -258,7 +325,7 @@ void ControllableSprite::update(Milliseconds elapsedTime) {
 
 	this->time_elapsed += elapsedTime * this->timescale;
 
-	const Milliseconds timeBeforeUpdate = this->animation_current->frames.at(this->frame_index).duration; // time current animation frame is supposed to be displayed
+	const Milliseconds timeBeforeUpdate = this->animation_current->frame(this->frame_index).duration; // time current animation frame is supposed to be displayed
 
 	if (this->time_elapsed > timeBeforeUpdate) {
 		this->time_elapsed = 0.;
@@ -275,7 +342,7 @@ void ControllableSprite::update(Milliseconds elapsedTime) {
 		}
 	}
 
-	const auto &rect = this->animation_current->frames.at(this->frame_index).rect;
+	const auto &rect = this->animation_current->frame(this->frame_index).rect;
 
 	this->current_sprite.setTextureRect(sf::IntRect(
 		rect.x, rect.y,
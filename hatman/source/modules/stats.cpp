@@ -130,20 +130,24 @@ HealthbarDisplay::HealthbarDisplay(const Vector2d &parentPosition, const Health
 	corner_alignment(bottomCenterpointAlignment - Vector2d(HealthbarDisplay_consts::HEALTHBAR_SIZE.x / 2., HealthbarDisplay_consts::HEALTHBAR_SIZE.y))
 {
 	// Load texture
-	this->sprite.setTexture(Graphics::ACCESS->getTexture_GUI("healthbar.png"));
+	this->texture_region = Graphics::ACCESS->getTextureRegion_GUI("healthbar.png");
+	this->sprite.setTexture(*this->texture_region.texture);
 }
 
 void HealthbarDisplay::draw() {
 	const double percentage = this->parent_health.percentage();
 
+	const int entityLayer = Graphics::READ->get_layer();
+	Graphics::ACCESS->set_layer(world_layers::HEALTHBARS); // should be above all entities
+
 
 	// Draw healthbar fill
-	this->sprite.setTextureRect(sf::IntRect(
+	this->sprite.setTextureRect(this->texture_region.subrect(sf::IntRect(
 		1,
 		1,
 		static_cast<int>(18. * percentage),
 		2
-	));
+	)));
 
 	this->sprite.setPosition(
 		static_cast<float>(this->parent_position.x + this->corner_alignment.x + 1.),
@@ -155,12 +159,12 @@ void HealthbarDisplay::draw() {
 	Graphics::ACCESS->camera->draw_sprite(this->sprite);
 
 	// Draw healthbar frame
-	this->sprite.setTextureRect(sf::IntRect(
+	this->sprite.setTextureRect(this->texture_region.subrect(sf::IntRect(
 		0,
 		4,
 		20,
 		4
-	));
+	)));
 
 	this->sprite.setPosition(
 		static_cast<float>(this->parent_position.x + this->corner_alignment.x),
@@ -170,6 +174,8 @@ void HealthbarDisplay::draw() {
 	// > no scaling needed
 
 	Graphics::ACCESS->camera->draw_sprite(this->sprite);
+
+	Graphics::ACCESS->set_layer(entityLayer);
 }
 
 
@@ -203,7 +209,8 @@ BossHealthbarDisplay::BossHealthbarDisplay(const Health &parentHealth, const std
 	boss_title(bossTitle)
 {
 	// Load texture
-	this->sprite.setTexture(Graphics::ACCESS->getTexture_GUI("boss_healthbar.png"));
+	this->texture_region = Graphics::ACCESS->getTextureRegion_GUI("boss_healthbar.png");
+	this->sprite.setTexture(*this->texture_region.texture);
 }
 
 void BossHealthbarDisplay::draw() {
@@ -214,12 +221,12 @@ void BossHealthbarDisplay::draw() {
 	const double percentage = this->parent_health.percentage();
 
 	// Draw healthbar fill
-	this->sprite.setTextureRect(sf::IntRect(
+	this->sprite.setTextureRect(this->texture_region.subrect(sf::IntRect(
 		FILL_CORNER.x,
 		FILL_CORNER.y,
 		static_cast<int>(FILL_SIZE.x * percentage),
 		FILL_SIZE.y
-	));
+	)));
 
 	this->sprite.setPosition(
 		static_cast<float>(CORNER_ALIGNMENT.x + FILL_CORNER.x),
@@ -229,12 +236,12 @@ void BossHealthbarDisplay::draw() {
 	Graphics::ACCESS->gui->draw_sprite(this->sprite);
 
 	// Draw healthbar frame
-	this->sprite.setTextureRect(sf::IntRect(
+	this->sprite.setTextureRect(this->texture_region.subrect(sf::IntRect(
 		FRAME_CORNER.x,
 		FRAME_CORNER.y,
 		FRAME_SIZE.x,
 		FRAME_SIZE.y
-	));
+	)));
 
 	this->sprite.setPosition(
 		static_cast<float>(CORNER_ALIGNMENT.x),
@@ -12,7 +12,7 @@ Item::Item(const std::string &name, const std::string &label, const std::string
 	description_lore(lore),
 	description_effect(effect)
 {
-	this->sprite.setTexture(Graphics::ACCESS->getTexture_Item(this->name + ".png"));
+	Graphics::ACCESS->getTextureRegion_Item(this->name + ".png").apply(this->sprite);
 	this->sprite.setScale(2, 2);
 }
 
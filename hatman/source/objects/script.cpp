@@ -1,5 +1,7 @@
 #include "objects/script.h"
 
+#include <algorithm> // 'max()'
+
 #include "systems/game.h" // access to game state
 #include "systems/controls.h" // access to control keys
 #include "graphics/graphics.h" // acess to GUI for text creation
@@ -8,6 +10,18 @@
 
 
 
+// Level transitions
+static bool _player_is_near(const dRect &hitbox) { // true if player hitbox is within preload distance of a given one
+	const auto playerHitbox = Game::READ->level->player->solid->getHitbox();
+
+	const double dx = std::max({ 0., hitbox.getLeft() - playerHitbox.getRight(), playerHitbox.getLeft() - hitbox.getRight() });
+	const double dy = std::max({ 0., hitbox.getTop() - playerHitbox.getBottom(), playerHitbox.getTop() - hitbox.getBottom() });
+
+	return dx * dx + dy * dy < performance::LEVEL_PRELOAD_DISTANCE * performance::LEVEL_PRELOAD_DISTANCE;
+}
+
+
+
 // # LevelChange #
 scripts::LevelChange::LevelChange(const dRect &hitbox, const std::string &goesToLevel, const Vector2 &goesToPos) :
 	hitbox(hitbox),
@@ -19,6 +33,9 @@ void scripts::LevelChange::update([[maybe_unused]] Milliseconds elapsedTime) {
 	if (Game::READ->level->player->solid->getHitbox().overlapsWithRect(this->hitbox)) {
 		Game::ACCESS->request_levelChange(this->goes_to_level, this->goes_to_pos);
 	}
+	else if (_player_is_near(this->hitbox)) {
+		Game::ACCESS->request_levelPreload(this->goes_to_level);
+	}
 }
 
 
@@ -36,6 +53,9 @@ void scripts::LevelSwitch::update([[maybe_unused]] Milliseconds elapsedTime) {
 
 		Game::ACCESS->request_levelChange(this->goes_to_level, this->goes_to_pos);
 	}
+	else if (_player_is_near(this->hitbox)) {
+		Game::ACCESS->request_levelPreload(this->goes_to_level);
+	}
 }
 
 
@@ -63,7 +83,7 @@ void scripts::Portal::update([[maybe_unused]] Milliseconds elapsedTime) {
 
 		Graphics::ACCESS->gui->Fade_on(colors::SH_BLACK, colors::SH_BLACK.transparent(), defaults::TRANSITION_FADE_DURATION);
 
-		Game::ACCESS->level->player->position = this->goes_to_pos;
+		Game::ACCESS->level->player->teleport(this->goes_to_pos);
 		Game::ACCESS->level->player->cameraTrap_center();
 	}
 }
@@ -34,12 +34,8 @@ void TileInteraction::setOutput(const std::string &emit, int lifetime) {
 
 // # Tile #
 Tile::Tile(const Tile &other) :
-	position(other.position),
-	tilesheet_sprite(other.tilesheet_sprite)
+	position(other.position)
 {
-	if (other.hitbox) { this->hitbox = std::make_unique<TileHitbox>(*other.hitbox); }
-	else { this->hitbox = nullptr; }
-
 	if (other.sprite) { this->sprite = nullptr;/*std::make_unique<Sprite>(*other.sprite);*/ }
 	else { this->sprite = nullptr; }
 
@@ -48,24 +44,15 @@ Tile::Tile(const Tile &other) :
 }
 Tile::Tile(Tile &&other) : 
 	position(other.position),
-	hitbox(std::move(other.hitbox)),
 	sprite(std::move(other.sprite)),
 	interaction(std::move(other.interaction))
 {}
 
 Tile::Tile(const Tileset &tileset, int id, const Vector2 position) :
 	position(position),
-	hitbox(nullptr),
 	sprite(nullptr),
 	interaction(nullptr)
 {
-	// set hitbox (if present)
-	if (tileset.has_tile_hitbox(id)) {
-		this->hitbox = std::make_unique<TileHitbox>(tileset.get_tile_hitbox(id));
-
-		for (auto& hitboxRect : this->hitbox->rectangles) { hitboxRect.rect.moveBy(this->position); }
-	}
-
 	// set animation (if present)
 	if (tileset.has_tile_animation(id)) {
 		this->sprite = std::make_unique<AnimatedSprite>(
@@ -255,7 +242,7 @@ void Tileset::parseFromJSON(const std::string &filePath) {
 				frames.push_back(AnimationFrame{ frameRect, frameDuration });
 			}
 
-			this->tileAnimations[tileId] = Animation(*this->texture, frames);
+			this->tileAnimations[tileId] = Animation(*this->texture, std::move(frames));
 		}
 	}
 
@@ -335,6 +322,11 @@ bool Tileset::has_tile_hitbox(int tileId) const { return this->tileHitboxes.coun
 
 TileHitbox Tileset::get_tile_hitbox(int tileId) const { return this->tileHitboxes.at(tileId); }
 
+const TileHitbox* Tileset::find_tile_hitbox(int tileId) const {
+	const auto it = this->tileHitboxes.find(tileId);
+	return (it != this->tileHitboxes.end()) ? &it->second : nullptr;
+}
+
 // Animation getters
 bool Tileset::has_tile_animation(int tileId) const { return this->tileAnimations.count(tileId); }
 
@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include "systems/profiler.h" // profiling zones
 #include "utility/globalconsts.hpp"
 
 
@@ -22,6 +23,7 @@ Audio::Audio(int music_volume_setting, int sound_volume_setting) :
 
 // - Sounds -
 
+#ifndef HATMAN_HEADLESS
 const sf::SoundBuffer& Audio::getSoundBuffer(const std::string &name) {
 	auto it = this->loadedAudio.find(name);
 
@@ -38,6 +40,25 @@ const sf::SoundBuffer& Audio::getSoundBuffer(const std::string &name) {
 	// Sound loaded => return
 	return it->second;
 }
+#endif
+
+Milliseconds Audio::getSoundDuration(const std::string &name) {
+	auto it = this->loadedDurations.find(name);
+
+	// Duration not known => read it from the file
+	if (it == this->loadedDurations.end()) {
+		sf::InputSoundFile file;
+		file.openFromFile("content/audio/fx/" + name);
+
+		// Computed from integer sample counts, so the value doesn't depend on float rounding of 'sf::Time'
+		const double seconds = (file.getChannelCount() && file.getSampleRate())
+			? static_cast<double>(file.getSampleCount()) / file.getChannelCount() / file.getSampleRate()
+			: 0.;
+		it = this->loadedDurations.try_emplace(name, sec_to_ms(seconds)).first;
+	}
+
+	return it->second;
+}
 
 // - Music -
 
@@ -61,6 +82,8 @@ void Audio::queue_music(const std::string &name) {
 }
 
 void Audio::update([[maybe_unused]] Milliseconds elapsedTime) {
+    const FrameProfiler::Zone zone("Audio::update");
+
     // Turbo-inefficient, but who cares
     
     if (this->music_do_fade_out) {       
@@ -91,7 +114,8 @@ void Audio::set_music(const std::string &name) {
     if (this->music_current == name) return; // don't repeat music if it's already playing
     
     this->music_current = name;
-    
+
+#ifndef HATMAN_HEADLESS
     // Load SFML music
     if (!music.openFromFile("content/audio/mx/" + name))
     	std::cout << "Error: Could not open music file...\n";
@@ -99,11 +123,14 @@ void Audio::set_music(const std::string &name) {
     music.setLoop(true); // for some reason music doesn't loop by default
     
     music.play();
+#endif
 }
 
-void Audio::set_music_volume(double volumeMod) {
+void Audio::set_music_volume([[maybe_unused]] double volumeMod) {
+#ifndef HATMAN_HEADLESS
     constexpr double SFML_MAX_VOLUME = 100; // SFML uses volume range [0, 100]
     const double total_volume = SFML_MAX_VOLUME * audio::MUSIC_BASE_VOLUME * Audio::READ->music_volume_mod * volumeMod;
     const float clamped_volume = std::clamp(static_cast<float>(total_volume), 0.f, 100.f);
     this->music.setVolume(clamped_volume);
+#endif
 }
\ No newline at end of file
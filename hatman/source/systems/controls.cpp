@@ -14,6 +14,7 @@ Controls::Controls() {
 	this->LMB = sf::Mouse::Button::Left;
 	this->ESC = sf::Keyboard::Key::Escape;
 	this->F3 = sf::Keyboard::Key::F3;
+	this->F4 = sf::Keyboard::Key::F4;
 
 	// Game controls
 	this->LEFT = sf::Keyboard::Key::A;
@@ -0,0 +1,171 @@
+#include "systems/entity_registry.h"
+
+
+
+// # EntityRegistry #
+ntt::EntityHandle EntityRegistry::insert(std::unique_ptr<ntt::Entity> &&entity) {
+	// Acquire slot
+	std::uint32_t slotIndex;
+
+	if (this->free_head != NONE) {
+		slotIndex = this->free_head;
+		this->free_head = this->slots[slotIndex].next_free;
+	}
+	else {
+		slotIndex = static_cast<std::uint32_t>(this->slots.size());
+		this->slots.emplace_back();
+	}
+
+	auto &slot = this->slots[slotIndex];
+	slot.dense_index = static_cast<std::uint32_t>(this->dense.size());
+	slot.next_free = NONE;
+	slot.group_index.fill(NONE);
+	slot.on_death_emit.clear();
+
+	const auto ptr = entity.get();
+	ptr->handle = ntt::EntityHandle{ slotIndex, slot.generation };
+
+	this->dense.push_back(std::move(entity));
+
+	// Add to groups
+	if (ptr->solid) this->_group_add(slotIndex, EntityGroup::SOLID);
+	if (ptr->solid && ptr->health) this->_group_add(slotIndex, EntityGroup::KILLABLE);
+
+	using Id = ntt::TypeId;
+
+	switch (ptr->type_id()) {
+	case Id::CREATURE:
+		this->_group_add(slotIndex, EntityGroup::CREATURE);
+		break;
+	case Id::ENEMY:
+		this->_group_add(slotIndex, EntityGroup::CREATURE);
+		this->_group_add(slotIndex, EntityGroup::ENEMY);
+		break;
+	case Id::PLAYER:
+		this->_group_add(slotIndex, EntityGroup::CREATURE);
+		break;
+	case Id::ITEM_ENTITY:
+		this->_group_add(slotIndex, EntityGroup::ITEM_ENTITY);
+		break;
+	case Id::DESTRUCTIBLE:
+		this->_group_add(slotIndex, EntityGroup::DESTRUCTIBLE);
+		break;
+	case Id::PROJECTILE:
+		this->_group_add(slotIndex, EntityGroup::PROJECTILE);
+		break;
+	case Id::PARTICLE:
+		this->_group_add(slotIndex, EntityGroup::PARTICLE);
+		break;
+	default:
+		break;
+	}
+
+	return ptr->handle;
+}
+
+std::unique_ptr<ntt::Entity> EntityRegistry::extract(ntt::EntityHandle handle) {
+	if (!this->_resolve(handle)) return nullptr;
+
+	auto &slot = this->slots[handle.index];
+
+	// Remove from groups
+	for (size_t group = 0; group < ENTITY_GROUP_COUNT; ++group)
+		if (slot.group_index[group] != NONE) this->_group_remove(handle.index, group);
+
+	// Swap-remove from dense storage
+	const std::uint32_t denseIndex = slot.dense_index;
+
+	std::unique_ptr<ntt::Entity> extracted = std::move(this->dense[denseIndex]);
+
+	if (denseIndex + 1 != this->dense.size()) {
+		this->dense[denseIndex] = std::move(this->dense.back());
+		this->slots[this->dense[denseIndex]->handle.index].dense_index = denseIndex;
+	}
+	this->dense.pop_back();
+
+	// Free the slot, new generation invalidates all existing handles
+	++slot.generation;
+	slot.dense_index = NONE;
+	slot.on_death_emit.clear();
+	slot.next_free = this->free_head;
+	this->free_head = handle.index;
+
+	extracted->handle = ntt::EntityHandle{};
+
+	return extracted;
+}
+
+void EntityRegistry::erase(ntt::EntityHandle handle) {
+	this->extract(handle); // extracted entity gets destroyed right away
+}
+
+ntt::Entity* EntityRegistry::get(ntt::EntityHandle handle) const {
+	const auto slot = this->_resolve(handle);
+
+	return slot ? this->dense[slot->dense_index].get() : nullptr;
+}
+
+bool EntityRegistry::in_group(ntt::EntityHandle handle, EntityGroup group) const {
+	const auto slot = this->_resolve(handle);
+
+	return slot && slot->group_index[static_cast<size_t>(group)] != NONE;
+}
+
+const std::vector<ntt::Entity*>& EntityRegistry::group(EntityGroup group) const {
+	return this->groups[static_cast<size_t>(group)];
+}
+
+void EntityRegistry::set_on_death_emit(ntt::EntityHandle handle, const Flag &flag) {
+	if (this->_resolve(handle)) this->slots[handle.index].on_death_emit = flag;
+}
+
+const Flag* EntityRegistry::get_on_death_emit(ntt::EntityHandle handle) const {
+	const auto slot = this->_resolve(handle);
+
+	return (slot && !slot->on_death_emit.empty()) ? &slot->on_death_emit : nullptr;
+}
+
+size_t EntityRegistry::size() const {
+	return this->dense.size();
+}
+
+ntt::Entity* EntityRegistry::operator[](size_t index) const {
+	return this->dense[index].get();
+}
+
+std::vector<std::unique_ptr<ntt::Entity>>::iterator EntityRegistry::begin() { return this->dense.begin(); }
+
+std::vector<std::unique_ptr<ntt::Entity>>::iterator EntityRegistry::end() { return this->dense.end(); }
+
+std::vector<std::unique_ptr<ntt::Entity>>::const_iterator EntityRegistry::begin() const { return this->dense.begin(); }
+
+std::vector<std::unique_ptr<ntt::Entity>>::const_iterator EntityRegistry::end() const { return this->dense.end(); }
+
+const EntityRegistry::Slot* EntityRegistry::_resolve(ntt::EntityHandle handle) const {
+	if (handle.index >= this->slots.size()) return nullptr;
+
+	const auto &slot = this->slots[handle.index];
+
+	return (slot.dense_index != NONE && slot.generation == handle.generation) ? &slot : nullptr;
+}
+
+void EntityRegistry::_group_add(std::uint32_t slotIndex, EntityGroup group) {
+	auto &members = this->groups[static_cast<size_t>(group)];
+
+	this->slots[slotIndex].group_index[static_cast<size_t>(group)] = static_cast<std::uint32_t>(members.size());
+	members.push_back(this->dense[this->slots[slotIndex].dense_index].get());
+}
+
+void EntityRegistry::_group_remove(std::uint32_t slotIndex, size_t group) {
+	auto &members = this->groups[group];
+	const std::uint32_t index = this->slots[slotIndex].group_index[group];
+
+	// Move last member into the freed position
+	if (index + 1 != members.size()) {
+		members[index] = members.back();
+		this->slots[members[index]->handle.index].group_index[group] = index;
+	}
+	members.pop_back();
+
+	this->slots[slotIndex].group_index[group] = NONE;
+}
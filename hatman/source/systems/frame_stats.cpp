@@ -0,0 +1,143 @@
+#include "systems/frame_stats.h"
+
+#include <algorithm> // 'nth_element()', 'max()', 'min()'
+#include <iomanip> // 'setprecision()'
+#include <vector> // related type (percentile scratch)
+
+
+
+// # FrameStats #
+static Milliseconds percentile(std::vector<Milliseconds> &times, double fraction) {
+	// nearest-rank percentile, partially reorders 'times'
+	const size_t rank = static_cast<size_t>(fraction * (times.size() - 1) + 0.5);
+
+	std::nth_element(times.begin(), times.begin() + rank, times.end());
+
+	return times[rank];
+}
+
+FrameStats::FrameStats() :
+	window_time(0.),
+	time_since_refresh(0.)
+{
+	this->session_histogram.fill(0);
+}
+
+void FrameStats::record(Milliseconds frameTime, Milliseconds updateTime, Milliseconds drawTime) {
+	// Hitches are judged against the median of the last refresh, the very first frames have no baseline
+	const bool isHitch =
+		this->window_summary.frames > 0 &&
+		frameTime > std::max(HITCH_FACTOR * this->window_summary.p50, HITCH_MIN_MS);
+
+	// Window
+	this->window_samples.push_back(Sample{ frameTime, updateTime, drawTime, isHitch });
+	this->window_time += frameTime;
+
+	while (this->window_samples.size() > 1 && this->window_time - this->window_samples.front().frame >= WINDOW_MS) {
+		this->window_time -= this->window_samples.front().frame;
+		this->window_samples.pop_front();
+	}
+
+	// Session
+	const size_t bucket = std::min(static_cast<size_t>(frameTime / HISTOGRAM_RESOLUTION_MS), HISTOGRAM_BUCKETS - 1);
+	++this->session_histogram[bucket];
+
+	auto &totals = this->session_totals;
+	++totals.frames;
+	if (isHitch) ++totals.hitches;
+	totals.max = std::max(totals.max, frameTime);
+	totals.avg_update += updateTime;
+	totals.avg_draw += drawTime;
+
+	// Refresh window stats (the first frame refreshes immediately to get a baseline)
+	this->time_since_refresh += frameTime;
+
+	if (this->time_since_refresh >= REFRESH_RATE_MS || this->window_summary.frames == 0) {
+		this->time_since_refresh = 0.;
+		this->_refresh();
+	}
+}
+
+const FrameStats::Summary& FrameStats::window() const {
+	return this->window_summary;
+}
+
+FrameStats::Summary FrameStats::session() const {
+	Summary summary = this->session_totals;
+
+	if (summary.frames == 0) return summary;
+
+	summary.avg_update /= summary.frames;
+	summary.avg_draw /= summary.frames;
+
+	// Walk the histogram once, every percentile takes the upper edge of the bucket its rank falls into
+	const double fractions[] = { 0.50, 0.95, 0.99 };
+	Milliseconds* const targets[] = { &summary.p50, &summary.p95, &summary.p99 };
+
+	size_t next = 0;
+	size_t accumulated = 0;
+
+	for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS && next < 3; ++bucket) {
+		accumulated += this->session_histogram[bucket];
+
+		while (next < 3 && accumulated > fractions[next] * (summary.frames - 1)) {
+			*targets[next] = std::min((bucket + 1) * HISTOGRAM_RESOLUTION_MS, summary.max);
+			++next;
+		}
+	}
+
+	return summary;
+}
+
+const std::deque<FrameStats::Sample>& FrameStats::samples() const {
+	return this->window_samples;
+}
+
+void FrameStats::write_summary(std::ostream &stream) const {
+	const Summary summary = this->session();
+
+	const auto flags = stream.flags();
+	const auto precision = stream.precision();
+
+	stream
+		<< std::fixed << std::setprecision(2)
+		<< "Frame time summary\n"
+		<< "  frames:  " << summary.frames << "\n"
+		<< "  hitches: " << summary.hitches << " (>" << HITCH_FACTOR << "x median and >" << HITCH_MIN_MS << " ms)\n"
+		<< "  p50:     " << summary.p50 << " ms\n"
+		<< "  p95:     " << summary.p95 << " ms\n"
+		<< "  p99:     " << summary.p99 << " ms\n"
+		<< "  max:     " << summary.max << " ms\n"
+		<< "  update:  " << summary.avg_update << " ms (average)\n"
+		<< "  draw:    " << summary.avg_draw << " ms (average)\n";
+
+	stream.flags(flags);
+	stream.precision(precision);
+}
+
+void FrameStats::_refresh() {
+	Summary summary;
+
+	summary.frames = this->window_samples.size();
+
+	std::vector<Milliseconds> times;
+	times.reserve(summary.frames);
+
+	for (const auto &sample : this->window_samples) {
+		times.push_back(sample.frame);
+
+		if (sample.is_hitch) ++summary.hitches;
+		summary.max = std::max(summary.max, sample.frame);
+		summary.avg_update += sample.update;
+		summary.avg_draw += sample.draw;
+	}
+
+	summary.avg_update /= summary.frames;
+	summary.avg_draw /= summary.frames;
+
+	summary.p50 = percentile(times, 0.50);
+	summary.p95 = percentile(times, 0.95);
+	summary.p99 = percentile(times, 0.99);
+
+	this->window_summary = summary;
+}
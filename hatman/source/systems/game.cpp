@@ -1,7 +1,12 @@
 #include "systems/game.h"
 
 #include <chrono>
+#include <cmath> // 'floor()'
+#include <cstdio> // 'snprintf()' (F3 number formatting)
+#include <cstring> // 'memcpy()' (hashing values)
+#include <fstream> // writing frame stats summary
 #include <iostream>
+#include <utility> // 'exchange()'
 
 #include <SFML/Audio.hpp>
 #include <SFML/Audio/Music.hpp>
@@ -10,8 +15,10 @@
 
 #include "graphics/graphics.h" // access to rendering updating
 #include "systems/audio.h"
+#include "systems/replay.h" // recording and replaying input
 #include "systems/saver.h" // access to save loading
 #include "systems/emit.h" // acess to 'EmitStorage' (DEV method _drawInfo())
+#include "systems/profiler.h" // profiling zones, trace dumps
 #include "utility/globalconsts.hpp"
 #include "utility/color.hpp" // coloring F3 GUI
 #include "systems/controls.h" // controls for GUI
@@ -20,6 +27,48 @@
 
 
 // # Game #
+namespace Game_consts {
+	const std::string PROFILE_FILEPATH = "profile_trace.json";
+	const std::string FRAME_STATS_FILEPATH = "frame_stats.txt";
+
+	// Frame stats overlay (F3)
+	constexpr double STATS_GRAPH_WIDTH = 200.; // 1 pixel per frame, newest frames are on the right
+	constexpr double STATS_GRAPH_HEIGHT = 40.;
+	constexpr Milliseconds STATS_GRAPH_SCALE_MS = 50.; // frame time at the full graph height
+	constexpr Milliseconds STATS_FRAME_BUDGET_MS = 1000. / 60.; // frames over budget are highlighted
+
+	constexpr auto STATS_GRAPH_BACKGROUND = colors::SH_BLACK.set_alpha(160);
+	constexpr auto STATS_GRAPH_COLOR = colors::SH_GREEN;
+	constexpr auto STATS_GRAPH_OVER_BUDGET_COLOR = colors::SH_YELLOW;
+	constexpr auto STATS_GRAPH_HITCH_COLOR = RGBColor(255, 0, 0);
+	constexpr auto STATS_GRAPH_BUDGET_LINE_COLOR = colors::SH_BLUE;
+}
+
+
+
+// State checksum
+// - FNV-1a over raw bytes of simulated values, doubles are hashed bitwise so any divergence shows up
+namespace {
+	constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+	constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+	template<typename T>
+	void hash_value(std::uint64_t &hash, const T &value) {
+		unsigned char bytes[sizeof(T)];
+		std::memcpy(bytes, &value, sizeof(T));
+
+		for (const auto byte : bytes) {
+			hash ^= byte;
+			hash *= FNV_PRIME;
+		}
+	}
+
+	void hash_string(std::uint64_t &hash, const std::string &value) {
+		for (const char symbol : value) hash_value(hash, symbol);
+		hash_value(hash, value.size());
+	}
+}
+
 const Game* Game::READ;
 Game* Game::ACCESS;
 
@@ -28,21 +77,29 @@ Game::Game(bool fps_counter_setting) :
     toggle_F3(false),
 	paused(false),
 	timescale(1.),
+	rng_seed(0),
+	level_cache(performance::LEVEL_CACHE_MEMORY),
 	_true_time_elapsed(0.),
 	_requested_go_to_main_menu(false),
 	_requested_toggle_esc_menu(false),
     _requested_toggle_inventory(false),
 	_requested_toggle_F3(false),
+	_requested_toggle_profiler(false),
 	_requested_exit_to_desktop(ExitCode::NONE),
 	_requested_level_load_from_save(false),
 	_requested_level_change(false),
-	level_change_is_reload(false)
+	_requested_camera_snap(false),
+	level_change_is_reload(false),
+	time_accumulator(0.),
+	step_alpha(1.)
 {
 	std::cout << "Creating game object...\n";
 
 	this->READ = this;
 	this->ACCESS = this;
 
+	rand_bind(&this->rng);
+
 	// Load main menu
 	std::cout << "Entering main menu...\n";
 	this->request_goToMainMenu();
@@ -55,12 +112,48 @@ Game::Game(bool fps_counter_setting) :
 	/// Game loop moved to outside
 }
 
-Game::~Game() {}
+Game::~Game() {
+	rand_bind(nullptr);
+
+	// Profile of the last frames is kept if the game was closed while profiling
+	if (FrameProfiler::get().is_enabled()) this->_dumpProfile();
+
+	if (this->frame_stats.session().frames) this->_writeFrameStats();
+}
 
 bool Game::is_running() const {
 	return static_cast<bool>(this->level);
 }
 
+double Game::interpolation_alpha() const {
+	return this->paused ? 1. : this->step_alpha; // paused simulation doesn't advance, so there is nothing to interpolate
+}
+
+std::uint64_t Game::state_checksum() const {
+	std::uint64_t hash = FNV_OFFSET;
+
+	hash_value(hash, TimerController::READ->now());
+	hash_value(hash, this->is_running());
+
+	if (!this->is_running()) return hash;
+
+	hash_string(hash, this->level->getName());
+	hash_value(hash, this->level->delayed_erase_count);
+	hash_value(hash, this->level->entities.size());
+
+	for (const auto &entity : this->level->entities) {
+		hash_value(hash, entity->handle.index);
+		hash_value(hash, entity->handle.generation);
+		hash_value(hash, entity->type_id());
+		hash_value(hash, entity->enabled);
+		hash_value(hash, entity->position.x);
+		hash_value(hash, entity->position.y);
+		if (entity->health) hash_value(hash, entity->health->hp);
+	}
+
+	return hash;
+}
+
 void  Game::request_levelLoadFromSave() {
 	if (this->_requested_level_load_from_save) return; // do nothing, process has already been initiated
 
@@ -80,10 +173,24 @@ void Game::request_levelChange(const std::string &newLevel, const Vector2d newPo
 	this->level_change_target = newLevel;
 	this->level_change_position = newPosition;
 
+	this->request_levelPreload(newLevel); // loading overlaps with the fade
+
 	Graphics::ACCESS->gui->Fade_on(colors::SH_BLACK.transparent(), colors::SH_BLACK, defaults::TRANSITION_FADE_DURATION);
 	this->smooth_transition_timer.start(defaults::TRANSITION_FADE_DURATION);
 }
 
+void Game::request_levelPreload(const std::string &levelName) {
+	if (this->level_preload_name == levelName || this->level_cache.contains(levelName)) return;
+
+	this->level_preload_name = levelName;
+	this->level_preload = std::async(std::launch::async, [levelName] {
+		PreloadedLevel preloaded;
+		preloaded.loaded = Level::loadData(levelName, preloaded.data);
+		return preloaded;
+	});
+		// if another level was being preloaded, reassignment waits for it to finish (a few ms at most)
+}
+
 void Game::request_levelReload() {
 	if (_requested_level_change) return; // do nothing, process has already been initiated
 
@@ -133,6 +240,10 @@ void Game::request_toggleF3() {
 	this->_requested_toggle_F3 = true;
 }
 
+void Game::request_toggleProfiler() {
+	this->_requested_toggle_profiler = true;
+}
+
 void Game::request_exitToDesktop() {
 	this->_requested_exit_to_desktop = ExitCode::EXIT;
 }
@@ -141,6 +252,10 @@ void Game::request_exitToRestart() {
 	this->_requested_exit_to_desktop = ExitCode::RESTART;
 }
 
+void Game::request_cameraSnap() {
+	this->_requested_camera_snap = true;
+}
+
 ExitCode Game::game_loop() {
 	using clock = std::chrono::high_resolution_clock;
 	auto frame_start = clock::now();
@@ -148,11 +263,11 @@ ExitCode Game::game_loop() {
 	auto &window = Graphics::ACCESS->window;
 
 	while (window.isOpen()) {
+		FrameProfiler::get().begin_frame();
+
 		// Poll events to the input object
 		sf::Event event;
 
-		this->input.begin_new_frame();
-
 		while (window.pollEvent(event)) {
 			switch (event.type) {
 			case sf::Event::MouseMoved:
@@ -179,31 +294,111 @@ ExitCode Game::game_loop() {
 			}
 		}
 
-		// Measure frame time (in ms) and update 
+		// Measure frame time (in ms)
 		const auto frame_end = clock::now();
 		const auto elapsed_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(frame_end - frame_start);
 		Milliseconds elapsedTime = elapsed_time_ns.count() / 1e6; // ns to ms
 		frame_start = frame_end; // next frame starts from the last end timestamp
 
+		const Milliseconds frameTime = elapsedTime; // stats see real frame time, clamping only protects simulation
+
 		if (elapsedTime > performance::MAX_FRAME_TIME_MS) elapsedTime = performance::MAX_FRAME_TIME_MS;
-			// fix for physics bugging out in low FPS moments
-			// this means below 1000/40=25 FPS physics start to slow down 
 
 		this->_true_time_elapsed = elapsedTime;
-		
-		const auto exit_code = this->handle_requests();
-		if (exit_code != ExitCode::NONE) return exit_code;
 
+		// Update in fixed steps, leftover time is carried over to the next frame
+		this->time_accumulator += elapsedTime * this->timescale; // this is all there is to timescale mechanic
+
+		// - when simulation falls behind, several steps are merged into one so slow machines
+		//   have fewer steps to catch up on, swept tile collisions keep larger steps stable
+		const auto update_start = clock::now();
+
+		while (this->time_accumulator >= performance::FIXED_TIMESTEP_MS) {
+			const double pendingSteps = std::floor(this->time_accumulator / performance::FIXED_TIMESTEP_MS);
+			const double mergedSteps = (pendingSteps > performance::MAX_MERGED_STEPS) ? performance::MAX_MERGED_STEPS : 1.;
+			const Milliseconds stepTime = mergedSteps * performance::FIXED_TIMESTEP_MS;
+
+			const auto exit_code = this->simulation_step(stepTime);
+			if (exit_code != ExitCode::NONE) return exit_code;
+
+			this->time_accumulator -= stepTime;
+		}
+
+		this->step_alpha = this->time_accumulator / performance::FIXED_TIMESTEP_MS;
+
+		const auto update_end = clock::now();
+
+		// Draw
 		DEBUG_SINGLETON::get().begin_new_frame(); // reset internal counters
 
-		this->update_everything(elapsedTime * this->timescale); // this is all there is to timescale mechanic
 		this->draw_everything();
+
+		const auto draw_end = clock::now();
+
+		Graphics::ACCESS->gui->FPSCounter_countFrame(this->_true_time_elapsed);
+
+		this->frame_stats.record(
+			frameTime,
+			std::chrono::duration<double, std::milli>(update_end - update_start).count(),
+			std::chrono::duration<double, std::milli>(draw_end - update_end).count()
+		);
+
+		FrameProfiler::get().end_frame();
 	}
 
 	// Should be unreachable
 	return ExitCode::EXIT;
 }
 
+ExitCode Game::run_frames(size_t frameCount) {
+	for (size_t i = 0; i < frameCount; ++i) {
+		this->_true_time_elapsed = performance::FIXED_TIMESTEP_MS;
+
+		FrameProfiler::get().begin_frame();
+
+		const auto exit_code = this->simulation_step(performance::FIXED_TIMESTEP_MS);
+		if (exit_code != ExitCode::NONE) return exit_code;
+
+		FrameProfiler::get().end_frame();
+	}
+
+	return ExitCode::NONE;
+}
+
+ExitCode Game::simulation_step(Milliseconds stepTime) {
+	const FrameProfiler::Zone zone("Game::simulation_step");
+
+	const auto exit_code = this->handle_requests();
+	if (exit_code != ExitCode::NONE) return exit_code;
+
+	this->camera_position_previous = Graphics::ACCESS->camera->position;
+
+	Milliseconds elapsedTime = stepTime;
+
+	if (this->input_replay) {
+		InputState state;
+		if (!this->input_replay->read_step(state, elapsedTime)) return ExitCode::EXIT;
+		this->input.set_state(state);
+	}
+
+	if (this->input_recorder) this->input_recorder->write_step(this->input.get_state(), elapsedTime);
+
+	this->update_everything(elapsedTime);
+
+	// State checksums of recorded and replayed runs must match step for step
+	if (this->input_recorder && this->input_recorder->checksum_due())
+		this->input_recorder->write_checksum(this->state_checksum());
+
+	if (this->input_replay && this->input_replay->checksum_due())
+		this->input_replay->verify_checksum(this->state_checksum());
+
+	this->input.begin_new_frame();
+		// pressed/released keys are consumed by the first step that sees them,
+		// frames that run no steps keep them for the next one
+
+	return ExitCode::NONE;
+}
+
 ExitCode Game::handle_requests() {
 	// Handle level change
 	if (this->_requested_level_change && this->smooth_transition_timer.finished()) {
@@ -273,6 +468,7 @@ ExitCode Game::handle_requests() {
 		// Return to main menu from game
 		if (this->is_running()) {
 			this->level.reset();
+			this->level_cache.clear();
 			Graphics::ACCESS->gui->MainMenu_on();
 		}
 		// Start up main menu
@@ -290,6 +486,7 @@ ExitCode Game::handle_requests() {
 		// Go to ending screen from game
 		if (this->is_running()) {
 			this->level.reset();
+			this->level_cache.clear();
 			Graphics::ACCESS->gui->EndingScreen_on();
 		}
 
@@ -305,11 +502,24 @@ ExitCode Game::handle_requests() {
 		this->_requested_toggle_F3 = false;
 	}
 
+	// Handle profiler toggle
+	if (this->_requested_toggle_profiler) {
+		auto &profiler = FrameProfiler::get();
+
+		if (profiler.is_enabled()) this->_dumpProfile();
+
+		profiler.set_enabled(!profiler.is_enabled());
+
+		this->_requested_toggle_profiler = false;
+	}
+
 	// Handle exit to desktop
 	return this->_requested_exit_to_desktop;
 }
 
 void Game::update_everything(Milliseconds elapsedTime) {
+	const FrameProfiler::Zone zone("Game::update_everything");
+
 	// Update during gameplay
 	if (this->is_running() && !this->paused) {
 		this->level->update(elapsedTime);
@@ -317,6 +527,13 @@ void Game::update_everything(Milliseconds elapsedTime) {
 		Graphics::ACCESS->camera->position = this->level->player->cameraTrap_getPosition();
 	}
 
+	// Teleports and level changes shouldn't slide the camera across the frame
+	if (this->_requested_camera_snap) {
+		this->camera_position_previous = Graphics::ACCESS->camera->position;
+
+		this->_requested_camera_snap = false;
+	}
+
 	// Updated regardless
     //this->update_music(elapsedTime);
     Audio::ACCESS->update(elapsedTime);
@@ -329,23 +546,39 @@ void Game::update_everything(Milliseconds elapsedTime) {
 }
 
 void Game::draw_everything() {
+	const FrameProfiler::Zone zone("Game::draw_everything");
+
 	// 1) Clear window
 	Graphics::ACCESS->window_clear();
 
-	// 2) Draw everything
+	// 2) Set up render passes, camera is placed in-between the last two simulation steps
+	auto &camera = Graphics::ACCESS->camera;
+
+	const Vector2d cameraPosition = camera->position;
+	camera->position = this->camera_position_previous + (cameraPosition - this->camera_position_previous) * this->interpolation_alpha();
+
+	Graphics::ACCESS->begin_world_pass();
+	Graphics::ACCESS->begin_overlay_pass();
+
+	// 3) Draw everything
 	if (this->is_running()) {
         this->level->draw();
     }
 
 	if (this->is_running() && this->toggle_F3) { /// perhaps move to GUI
+		Graphics::ACCESS->set_layer(world_layers::DEBUG);
 		this->_drawHitboxes();
 		this->_drawInfo();
+		this->_drawFrameStats();
 	}
 
+	Graphics::ACCESS->set_layer(world_layers::TEXT); // GUI can also draw in-world text
 	Graphics::ACCESS->gui->draw();
 
-	// 3) Display drawn objects
+	// 4) Display drawn objects
 	Graphics::ACCESS->window_display();
+
+	camera->position = cameraPosition;
 }
 
 // Level loading/changing
@@ -364,11 +597,13 @@ void Game::_level_swapToTarget() {
 	Graphics::ACCESS->camera->position = playerPtr->cameraTrap_getPosition();
 		// center camera at the player to prevent situation where player doesn't get
 		// updated due to being too far away from camera
+	this->request_cameraSnap();
 
-	this->level = std::make_unique<Level>(
-		this->level_change_target,
-		std::move(extractedPlayer)
-	); // construct new level and transfer player to it
+	this->_level_reseedRNG(this->level_change_target);
+
+	// Construct target level and transfer player to it, geometry of previous level is kept for later
+	auto previousLevel = std::exchange(this->level, this->_level_build(this->level_change_target, std::move(extractedPlayer)));
+	this->level_cache.store(std::move(previousLevel));
 
 	this->_requested_level_change = false;
 
@@ -390,6 +625,7 @@ void Game::_level_loadFromSave() {
 	Graphics::ACCESS->camera->position = constructedPlayer->cameraTrap_getPosition();
 		// center camera at the player to prevent situation where player doesn't get
 		// updated due to being too far away from camera
+	this->request_cameraSnap();
 
 	// Fill player inventory
 	constructedPlayer->inventory = std::move(savedInventory);
@@ -398,10 +634,10 @@ void Game::_level_loadFromSave() {
 	Flags::ACCESS->flags = std::move(savedFlags);
     
 	// Set level
-	this->level = std::make_unique<Level>(
-		savedLevel,
-		std::move(constructedPlayer)
-	);
+	this->_level_reseedRNG(savedLevel);
+
+	auto previousLevel = std::exchange(this->level, this->_level_build(savedLevel, std::move(constructedPlayer)));
+	this->level_cache.store(std::move(previousLevel)); // nothing is stored if game was just started
 
 	this->_requested_level_change = false;
 	this->level_change_is_reload = false;
@@ -409,6 +645,39 @@ void Game::_level_loadFromSave() {
 	Graphics::ACCESS->gui->AllPlayerGUI_on();
 }
 
+LevelData Game::_level_takeData(const std::string &levelName) {
+	if (this->level_preload_name == levelName && this->level_preload.valid()) {
+		this->level_preload_name.clear();
+
+		auto preloaded = this->level_preload.get(); // blocks if worker isn't done yet
+		if (!preloaded.loaded) UTL_LOG_ERR("Could not load level {", levelName, "}");
+
+		return std::move(preloaded.data);
+	}
+
+	return Level::loadData(levelName);
+}
+
+std::unique_ptr<Level> Game::_level_build(const std::string &levelName, std::unique_ptr<ntt::Entity> &&player) {
+	auto level = this->level_cache.take(levelName, std::move(player)); // player isn't consumed on a cache miss
+
+	if (!level) level = std::make_unique<Level>(levelName, this->_level_takeData(levelName), std::move(player));
+
+	return level;
+}
+
+void Game::_level_reseedRNG(const std::string &levelName) {
+	// FNV-1a, unlike 'std::hash' gives the same result on every platform
+	std::uint32_t hash = 2166136261u;
+
+	for (const char c : levelName) {
+		hash ^= static_cast<std::uint8_t>(c);
+		hash *= 16777619u;
+	}
+
+	this->rng.seed(this->rng_seed ^ hash);
+}
+
 // Testing
 void Game::_drawHitboxes() {
 	const int BORDER_TEXTURE_SIZE = 16;
@@ -429,51 +698,46 @@ void Game::_drawHitboxes() {
 	const int upperBound = std::max(centerIndex.y - performance::TILE_FREEZE_RANGE_Y, 0);
 	const int lowerBound = std::min(centerIndex.y + performance::TILE_FREEZE_RANGE_Y, this->level->getSizeY() - 1);
 
-	// Update tiles
+	// Draw tile hitboxes
 	for (int X = leftBound; X <= rightBound; ++X)
-		for (int Y = upperBound; Y <= lowerBound; ++Y) {
-			const auto tile = this->level->getTile(X, Y);
-
-			if (tile) {
-				// Draw hibox if present
-				if (tile->hitbox)
-					for (const auto& hitboxRect : tile->hitbox->rectangles) {
-						const dstRect destRect = hitboxRect.rect.to_dstRect();
-
-						tileHitboxBorder.setPosition(
-							static_cast<float>(destRect.x),
-							static_cast<float>(destRect.y)
-						);
-						tileHitboxBorder.setScale(
-							static_cast<float>(destRect.w / BORDER_TEXTURE_SIZE),
-							static_cast<float>(destRect.h / BORDER_TEXTURE_SIZE)
-						);
-
-						Graphics::ACCESS->camera->draw_sprite(tileHitboxBorder);
-					}
-				// Draw actionbox if present
-				if (tile->interaction) {
-					const dstRect destRect = tile->interaction->actionbox.to_dstRect();
-
-					tileActionboxBorder.setPosition(
-						static_cast<float>(destRect.x),
-						static_cast<float>(destRect.y)
-					);
-					tileActionboxBorder.setScale(
-						static_cast<float>(destRect.w / BORDER_TEXTURE_SIZE),
-						static_cast<float>(destRect.h / BORDER_TEXTURE_SIZE)
-					);
-
-					Graphics::ACCESS->camera->draw_sprite(tileActionboxBorder);
-				}
-			}
+		for (int Y = upperBound; Y <= lowerBound; ++Y)
+			this->level->collision_grid.for_each_rect(X, Y, [&](const TileHitboxRect &hitboxRect) {
+				const dstRect destRect = hitboxRect.rect.to_dstRect();
+
+				tileHitboxBorder.setPosition(
+					static_cast<float>(destRect.x),
+					static_cast<float>(destRect.y)
+				);
+				tileHitboxBorder.setScale(
+					static_cast<float>(destRect.w / BORDER_TEXTURE_SIZE),
+					static_cast<float>(destRect.h / BORDER_TEXTURE_SIZE)
+				);
+
+				Graphics::ACCESS->camera->draw_sprite(tileHitboxBorder);
+			});
+
+	// Draw tile actionboxes (only tiles with objects can have them)
+	for (const auto &tile : this->level->getTileObjects())
+		if (tile->interaction) {
+			const dstRect destRect = tile->interaction->actionbox.to_dstRect();
+
+			tileActionboxBorder.setPosition(
+				static_cast<float>(destRect.x),
+				static_cast<float>(destRect.y)
+			);
+			tileActionboxBorder.setScale(
+				static_cast<float>(destRect.w / BORDER_TEXTURE_SIZE),
+				static_cast<float>(destRect.h / BORDER_TEXTURE_SIZE)
+			);
+
+			Graphics::ACCESS->camera->draw_sprite(tileActionboxBorder);
 		}
 
 	// Draw entity hitboxes
 	sf::Sprite entityHitboxBorder;
 	entityHitboxBorder.setTexture(Graphics::ACCESS->getTexture("content/textures/hitbox_border_entity.png"));
 
-	for (const auto &entity : this->level->entities_solid) {
+	for (const auto &entity : this->level->entities.group(EntityGroup::SOLID)) {
 		const dstRect destRect = entity->solid->getHitbox().to_dstRect();
 
 		entityHitboxBorder.setPosition(
@@ -550,4 +814,122 @@ void Game::_reset_graphics() {
 	//Graphics graphics(window_width, window_height, screen_mode);
 
 	//*(Graphics::ACCESS) = Graphics(window_width, window_height, screen_mode);
-}
\ No newline at end of file
+}
+
+// Profiling
+static std::string format_number(double value) {
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+	return buffer;
+}
+
+void Game::_drawFrameStats() {
+	using namespace Game_consts;
+
+	Font* const font = Graphics::ACCESS->gui->fonts.at("BLOCKY").get();
+	constexpr double gapX = 50.;
+	constexpr double gapY = 8.;
+
+	const auto origin = Vector2d(natural::WIDTH - 2. - STATS_GRAPH_WIDTH, 2.);
+	const auto cell = [&](int col, int row) { return origin + Vector2d(col * gapX, row * gapY); };
+
+	const auto &window = this->frame_stats.window();
+	const auto session = this->frame_stats.session();
+
+	// Text
+	font->color_set(colors::SH_GREEN);
+
+	font->draw_line(cell(0, 0), "frame ms, last " + std::to_string(static_cast<int>(ms_to_sec(FrameStats::WINDOW_MS))) + " sec");
+	font->draw_line(cell(0, 1), "p50:");
+	font->draw_line(cell(1, 1), format_number(window.p50));
+	font->draw_line(cell(2, 1), "p95:");
+	font->draw_line(cell(3, 1), format_number(window.p95));
+	font->draw_line(cell(0, 2), "p99:");
+	font->draw_line(cell(1, 2), format_number(window.p99));
+	font->draw_line(cell(2, 2), "max:");
+	font->draw_line(cell(3, 2), format_number(window.max));
+	font->draw_line(cell(0, 3), "update:");
+	font->draw_line(cell(1, 3), format_number(window.avg_update));
+	font->draw_line(cell(2, 3), "draw:");
+	font->draw_line(cell(3, 3), format_number(window.avg_draw));
+	font->draw_line(cell(0, 4), "hitches:");
+	font->draw_line(cell(1, 4), std::to_string(window.hitches));
+	font->draw_line(cell(2, 4), "total:");
+	font->draw_line(cell(3, 4), std::to_string(session.hitches));
+	font->draw_line(cell(0, 5), "entities:");
+	font->draw_line(cell(1, 5), std::to_string(this->level->entities.size()));
+	font->draw_line(cell(2, 5), "particles:");
+	font->draw_line(cell(3, 5), std::to_string(this->level->particles.count()));
+	font->draw_line(cell(0, 6), "tiles:");
+	font->draw_line(cell(1, 6), std::to_string(this->level->getTileCount()));
+	font->draw_line(cell(2, 6), "tile objs:");
+	font->draw_line(cell(3, 6), std::to_string(this->level->getTileObjects().size()));
+	font->draw_line(cell(0, 7), "draw calls:");
+	font->draw_line(cell(1, 7), std::to_string(Graphics::READ->draw_calls()));
+
+	font->color_set(RGBColor(0, 0, 0));
+
+	// Graph
+	// - untextured quads: background, budget line and a bar per frame
+	const auto &samples = this->frame_stats.samples();
+	const size_t barCount = std::min(samples.size(), static_cast<size_t>(STATS_GRAPH_WIDTH));
+
+	auto &vertices = this->frame_stats_graph;
+	vertices.setPrimitiveType(sf::Quads);
+	vertices.resize((2 + barCount) * 4);
+
+	const double graphBottom = cell(0, 9).y + STATS_GRAPH_HEIGHT;
+
+	const auto set_quad = [&](size_t index, double left, double top, double right, double bottom, const RGBColor &color) {
+		const sf::Color sfColor(color.r, color.g, color.b, color.alpha);
+
+		sf::Vertex* quad = &vertices[index * 4];
+		quad[0] = sf::Vertex(sf::Vector2f(static_cast<float>(left), static_cast<float>(top)), sfColor);
+		quad[1] = sf::Vertex(sf::Vector2f(static_cast<float>(right), static_cast<float>(top)), sfColor);
+		quad[2] = sf::Vertex(sf::Vector2f(static_cast<float>(right), static_cast<float>(bottom)), sfColor);
+		quad[3] = sf::Vertex(sf::Vector2f(static_cast<float>(left), static_cast<float>(bottom)), sfColor);
+	};
+
+	const auto bar_top = [&](Milliseconds time) {
+		return graphBottom - std::min(time / STATS_GRAPH_SCALE_MS, 1.) * STATS_GRAPH_HEIGHT;
+	};
+
+	set_quad(0, origin.x, graphBottom - STATS_GRAPH_HEIGHT, origin.x + STATS_GRAPH_WIDTH, graphBottom, STATS_GRAPH_BACKGROUND);
+
+	for (size_t i = 0; i < barCount; ++i) {
+		const auto &sample = samples[samples.size() - barCount + i];
+
+		const RGBColor &color =
+			sample.is_hitch ? STATS_GRAPH_HITCH_COLOR :
+			(sample.frame > STATS_FRAME_BUDGET_MS) ? STATS_GRAPH_OVER_BUDGET_COLOR :
+			STATS_GRAPH_COLOR;
+
+		const double left = origin.x + STATS_GRAPH_WIDTH - barCount + i;
+
+		set_quad(1 + i, left, bar_top(sample.frame), left + 1., graphBottom, color);
+	}
+
+	const double budgetTop = bar_top(STATS_FRAME_BUDGET_MS);
+	set_quad(1 + barCount, origin.x, budgetTop, origin.x + STATS_GRAPH_WIDTH, budgetTop + 1., STATS_GRAPH_BUDGET_LINE_COLOR);
+
+	Graphics::ACCESS->queue_vertices(vertices, nullptr, RenderPass::OVERLAY);
+}
+
+void Game::_dumpProfile() const {
+	using namespace Game_consts;
+
+	if (FrameProfiler::get().dump_chrome_trace(PROFILE_FILEPATH)) std::cout << "Profile written to '" << PROFILE_FILEPATH << "'\n";
+	else std::cout << "Error: Could not write profile to '" << PROFILE_FILEPATH << "'\n";
+}
+
+void Game::_writeFrameStats() const {
+	using namespace Game_consts;
+
+	this->frame_stats.write_summary(std::cout);
+
+	std::ofstream file(FRAME_STATS_FILEPATH);
+	this->frame_stats.write_summary(file);
+
+	if (file) std::cout << "Frame stats written to '" << FRAME_STATS_FILEPATH << "'\n";
+	else std::cout << "Error: Could not write frame stats to '" << FRAME_STATS_FILEPATH << "'\n";
+}
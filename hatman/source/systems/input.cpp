@@ -6,61 +6,76 @@
 
 // # Input #
 void Input::begin_new_frame() { // pressed/released keys matter only for current 1 frame => we clear them each frame
-	this->keys_pressed.clear();
-	this->keys_released.clear();
-	this->buttons_pressed.clear();
-	this->buttons_released.clear();
+	this->state.keys_pressed.reset();
+	this->state.keys_released.reset();
+	this->state.buttons_pressed.reset();
+	this->state.buttons_released.reset();
 }
 
 void Input::event_MouseMove(const sf::Event &event) {
-	this->mouse_position.x = event.mouseMove.x / Graphics::READ->scaling_factor();
-	this->mouse_position.y = event.mouseMove.y / Graphics::READ->scaling_factor();
+	this->state.mouse_position.x = event.mouseMove.x / Graphics::READ->scaling_factor();
+	this->state.mouse_position.y = event.mouseMove.y / Graphics::READ->scaling_factor();
 }
 
 void Input::event_KeyDown(const sf::Event &event) {
-	this->keys_pressed[event.key.code] = true;
-	this->keys_held[event.key.code] = true;
+	if (event.key.code < 0 || event.key.code >= sf::Keyboard::KeyCount) return;
+
+	this->state.keys_pressed[event.key.code] = true;
+	this->state.keys_held[event.key.code] = true;
 }
 void Input::event_KeyUp(const sf::Event &event) {
-	this->keys_released[event.key.code] = true;
-	this->keys_held[event.key.code] = false;
+	if (event.key.code < 0 || event.key.code >= sf::Keyboard::KeyCount) return;
+
+	this->state.keys_released[event.key.code] = true;
+	this->state.keys_held[event.key.code] = false;
 }
 
 void Input::event_ButtonDown(const sf::Event &event) {
-	this->buttons_pressed[event.mouseButton.button] = true;
-	this->buttons_held[event.mouseButton.button] = true;
+	if (event.mouseButton.button >= sf::Mouse::ButtonCount) return;
+
+	this->state.buttons_pressed[event.mouseButton.button] = true;
+	this->state.buttons_held[event.mouseButton.button] = true;
 }
 void Input::event_ButtonUp(const sf::Event &event) {
-	this->buttons_released[event.mouseButton.button] = true;
-	this->buttons_held[event.mouseButton.button] = false;
+	if (event.mouseButton.button >= sf::Mouse::ButtonCount) return;
+
+	this->state.buttons_released[event.mouseButton.button] = true;
+	this->state.buttons_held[event.mouseButton.button] = false;
 }
 
 bool Input::key_pressed(sf::Keyboard::Key key) {
-	return this->keys_pressed[key];
+	return key >= 0 && key < sf::Keyboard::KeyCount && this->state.keys_pressed[key];
 }
 bool Input::key_released(sf::Keyboard::Key key) {
-	return this->keys_released[key];
+	return key >= 0 && key < sf::Keyboard::KeyCount && this->state.keys_released[key];
 }
 bool Input::key_held(sf::Keyboard::Key key) {
-	return this->keys_held[key];
+	return key >= 0 && key < sf::Keyboard::KeyCount && this->state.keys_held[key];
 }
 
 bool Input::mouse_pressed(sf::Mouse::Button button) {
-	return this->buttons_pressed[button];
+	return button < sf::Mouse::ButtonCount && this->state.buttons_pressed[button];
 }
 bool Input::mouse_released(sf::Mouse::Button button) {
-	return this->buttons_released[button];
+	return button < sf::Mouse::ButtonCount && this->state.buttons_released[button];
 }
 bool Input::mouse_held(sf::Mouse::Button button) {
-	return this->buttons_held[button];
+	return button < sf::Mouse::ButtonCount && this->state.buttons_held[button];
 }
 
 Vector2d Input::mousePosition() const {
-	return this->mouse_position;
+	return this->state.mouse_position;
 }
 double Input::mouseX() const {
-	return this->mouse_position.x;
+	return this->state.mouse_position.x;
 }
 double Input::mouseY() const {
-	return this->mouse_position.y;
+	return this->state.mouse_position.y;
+}
+
+const InputState& Input::get_state() const {
+	return this->state;
+}
+void Input::set_state(const InputState &state) {
+	this->state = state;
 }
@@ -1,10 +1,11 @@
 #include "systems/level.h"
 
-#include <chrono> // TEMP:
-#include <fstream> // parsing from JSON (opening a file)
+#include <algorithm> // 'min()', 'max()'
 #include <type_traits>
+#include <unordered_map> // tile kind lookup during construction
 
 #include "firstparty/UTL/log.hpp"
+#include "firstparty/UTL/parallel.hpp" // thread pool (entity physics)
 
 #include "entity/base.h"
 #include "graphics/graphics.h" // access to rendering (background)
@@ -14,20 +15,32 @@
 #include "entity/unique_m.h" // creation of unique entities
 #include "utility/globalconsts.hpp" // performnce-related consts
 #include "systems/audio.h" // to play music
+#include "systems/game.h" // access to interpolation alpha
+#include "systems/profiler.h" // profiling zones
 
 
 // # Level #
 Level::Level(const std::string &name) :
+	Level(name, Level::loadData(name))
+{}
+
+Level::Level(const std::string &name, LevelData data) :
 	player(nullptr),
+	data(std::move(data)),
 	levelName(name)
 {
-    const auto start = std::chrono::steady_clock::now();
-	this->parseFromJSON("content/levels/" + name + ".json");
-    std::cout << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms\n";
+	const FrameProfiler::Zone zone("Level::build");
+
+	this->_buildGeometry();
+	this->_buildObjects();
 }
 
 Level::Level(const std::string &name, std::unique_ptr<ntt::Entity> &&player) :
-	Level(name)
+	Level(name, Level::loadData(name), std::move(player))
+{}
+
+Level::Level(const std::string &name, LevelData data, std::unique_ptr<ntt::Entity> &&player) :
+	Level(name, std::move(data))
 {
     UTL_LOG_INFO("Loaded level {", name, "} with player ", player.get());
     
@@ -36,11 +49,52 @@ Level::Level(const std::string &name, std::unique_ptr<ntt::Entity> &&player) :
 	//this->spawn(std::move(player));
 }
 
+Level::Level(const std::string &name, LevelData data, Geometry &&geometry, std::unique_ptr<ntt::Entity> &&player) :
+	player(nullptr),
+	data(std::move(data)),
+	levelName(name)
+{
+	const FrameProfiler::Zone zone("Level::build");
+
+	this->tilesets = std::move(geometry.tilesets);
+	this->map_size = this->data.size;
+
+	this->tile_kinds = std::move(geometry.tile_kinds);
+	this->tiles = std::move(geometry.tiles);
+	this->tile_count = geometry.tile_count;
+
+	this->collision_grid = std::move(geometry.collision_grid);
+
+	this->mesh_backlayer = std::move(geometry.mesh_backlayer);
+	this->mesh_tiles = std::move(geometry.mesh_tiles);
+	this->mesh_frontlayer = std::move(geometry.mesh_frontlayer);
+
+	this->_buildObjects();
+
+	UTL_LOG_INFO("Loaded level {", name, "} from cache with player ", player.get());
+
+	this->_insertNewEntity(std::move(player));
+}
+
+LevelData Level::loadData(const std::string &name) {
+	LevelData data;
+	if (!Level::loadData(name, data)) UTL_LOG_ERR("Could not load level {", name, "}");
+	return data;
+}
+
+bool Level::loadData(const std::string &name, LevelData &data) {
+	return data.load("content/levels/" + name + ".json");
+}
+
 void Level::update(Milliseconds elapsedTime) {
+	const FrameProfiler::Zone zone("Level::update");
+
+	// Save positions for interpolation
+	for (auto &entity : this->entities) entity->position_previous = entity->position;
+
 	// Spawn new entities
 	if (this->_spawn_queue.size()) {
 		this->_insertFromSpawnQueue();
-		this->_spawn_queue.clear();
 	}
 
 	const auto cameraPos = this->player->cameraTrap_getPosition();
@@ -53,31 +107,75 @@ void Level::update(Milliseconds elapsedTime) {
 	const int lowerBound = std::min(centerIndex.y + performance::TILE_FREEZE_RANGE_Y, this->map_size.y - 1);
 
 	// Update tiles
-	for (int X = leftBound; X <= rightBound; ++X)
-		for (int Y = upperBound; Y <= lowerBound; ++Y) {
-			const auto tileIndex = this->_getTile1DIndex(X, Y);
+	// - static tiles have no objects, so the list is short enough to be filtered by range directly
+	{
+		const FrameProfiler::Zone zone("Level::update tiles");
 
-			const auto tile = this->tiles[tileIndex].get();
+		for (auto &tile : this->tile_objects) {
+			const Vector2 tileIndex = helpers::divide32(tile->position);
 
-			if (tile) tile->update(elapsedTime);
+			if (leftBound <= tileIndex.x && tileIndex.x <= rightBound &&
+				upperBound <= tileIndex.y && tileIndex.y <= lowerBound)
+				tile->update(elapsedTime);
 		}
+	}
+
+	// Update entities in two phases
+	// - physics: solids only change their own entity and read static tiles, so they run in parallel
+	// - logic: AI, damage, impulses, spawns and erase marks run serially in registry order,
+	//   effects on physics of other entities (impulses, disabling) are picked up on the next step
+	this->_update_list.clear();
 
-	// Update entities
 	for (auto &entity : this->entities)
 		if (std::abs(cameraPos.x - entity->position.x) < performance::ENTITY_FREEZE_RANGE_X &&
 			std::abs(cameraPos.y - entity->position.y) < performance::ENTITY_FREEZE_RANGE_Y)
-			entity->update(elapsedTime);
+			this->_update_list.push_back(entity.get());
+
+	{
+		const FrameProfiler::Zone zone("Level::update physics");
+
+		this->_updatePhysics(elapsedTime);
+	}
+
+	// Rebuild broadphase
+	// - done after physics, so logic queries see hitboxes where they are this step no matter how far solids moved
+	//   (merged steps included), logic itself only moves entities through 'Entity::teleport()', which relocates them
+	// - grid isn't queried outside of the logic phase, so entities erased below don't leave dangling entries in use
+	this->entities_grid.rebuild(this->entities.group(EntityGroup::KILLABLE));
+
+	{
+		const FrameProfiler::Zone zone("Level::update entities");
+
+		for (const auto entity : this->_update_list) entity->update(elapsedTime);
+	}
+
+	// Update particles
+	{
+		const FrameProfiler::Zone zone("Level::update particles");
+
+		this->particles.update(elapsedTime);
+	}
 
 	// Erase 'dead' entities
-	this->_eraseMarkedEntities();
+	{
+		const FrameProfiler::Zone zone("Level::update erase");
+
+		this->_eraseMarkedEntities();
+	}
 
 	// Update scripts
-	for (auto &script : this->scripts) { script.update(elapsedTime); }
+	{
+		const FrameProfiler::Zone zone("Level::update scripts");
+
+		for (auto &script : this->scripts) { script.update(elapsedTime); }
+	}
 }
 
 void Level::draw() {
+	const FrameProfiler::Zone zone("Level::draw");
+
 	// Draw background
-	Graphics::ACCESS->gui->draw_sprite(this->background_sprite);
+	Graphics::ACCESS->queue_sprite(this->background_sprite, RenderPass::BACKGROUND);
 
 	const auto cameraPos = this->player->cameraTrap_getPosition();
 
@@ -88,34 +186,38 @@ void Level::draw() {
 	const int upperBound = std::max(centerIndex.y - performance::TILE_DRAW_RANGE_Y, 0);
 	const int lowerBound = std::min(centerIndex.y + performance::TILE_DRAW_RANGE_Y, this->map_size.y - 1);
 
-	// Draw [backlayer]->[layer]->[midlayer]
-	for (int X = leftBound; X <= rightBound; ++X)
-		for (int Y = upperBound; Y <= lowerBound; ++Y) {
-			const auto tileIndex = this->_getTile1DIndex(X, Y);
-
-			const auto backtile = this->tiles_backlayer[tileIndex].get();
-			const auto tile = this->tiles[tileIndex].get();
+	const Vector2 cornerIndex(leftBound, upperBound);
+	const Vector2 endIndex(rightBound, lowerBound);
 
-			if (backtile) backtile->draw();
-			if (tile) tile->draw();
-		}
+	// Draw [backlayer]->[layer]
+	Graphics::ACCESS->set_layer(world_layers::TILES_BACKLAYER);
+	this->mesh_backlayer.draw(cornerIndex, endIndex);
 
+	Graphics::ACCESS->set_layer(world_layers::TILES);
+	this->mesh_tiles.draw(cornerIndex, endIndex);
 
 	// Draw entities
+	// - entities are drawn in-between their last two simulated positions, since all
+	//   position-dependant drawing goes through 'entity->position' it's swapped temporarily
+	Graphics::ACCESS->set_layer(world_layers::ENTITIES);
+
+	const double alpha = Game::READ->interpolation_alpha();
+
 	for (const auto &entity : this->entities)
 		if (cameraPos.x - entity->position.x < performance::ENTITY_DRAW_RANGE_X &&
-			cameraPos.y - entity->position.y < performance::ENTITY_DRAW_RANGE_Y)
-			entity->draw();
+			cameraPos.y - entity->position.y < performance::ENTITY_DRAW_RANGE_Y) {
+			const Vector2d simulatedPosition = entity->position;
 
-	// Draw [frontlayer]
-	for (int X = leftBound; X <= rightBound; ++X)
-		for (int Y = upperBound; Y <= lowerBound; ++Y) {
-			const auto tileIndex = this->_getTile1DIndex(X, Y);
+			entity->position = entity->position_previous + (simulatedPosition - entity->position_previous) * alpha;
+			entity->draw();
+			entity->position = simulatedPosition;
+		}
 
-			const auto fronttile = this->tiles_frontlayer[tileIndex].get();
+	this->particles.draw();
 
-			if (fronttile) fronttile->draw();
-		}
+	// Draw [frontlayer]
+	Graphics::ACCESS->set_layer(world_layers::TILES_FRONTLAYER);
+	this->mesh_frontlayer.draw(cornerIndex, endIndex);
 }
 
 // Getters
@@ -127,13 +229,13 @@ int Level::getSizeY() const { return this->map_size.y; }
 
 const std::string& Level::getName() const { return this->levelName; }
 
-Tile* Level::getTile(const Vector2 &index) {
-	return this->tiles[this->_getTile1DIndex(index.x, index.y)].get();
+bool Level::hasTile(int indexX, int indexY) const {
+	return this->tiles[this->_getTile1DIndex(indexX, indexY)] != NO_TILE;
 }
 
-Tile* Level::getTile(int indexX, int indexY) {
-	return this->tiles[this->_getTile1DIndex(indexX, indexY)].get();
-}
+size_t Level::getTileCount() const { return this->tile_count; }
+
+const std::vector<std::unique_ptr<Tile>>& Level::getTileObjects() const { return this->tile_objects; }
 
 // Entities
 void Level::spawn(std::unique_ptr<ntt::Entity> &&entity) {
@@ -141,113 +243,91 @@ void Level::spawn(std::unique_ptr<ntt::Entity> &&entity) {
 }
 
 std::unique_ptr<ntt::Entity> Level::_extractPlayer() {
-	std::unique_ptr<ntt::Entity> extracted;
+	auto extracted = this->entities.extract(this->player->handle);
+	this->player = nullptr;
+	return extracted;
+}
 
-	for (auto &entity : this->entities)
-		if (entity.get() == this->player)
-			extracted = std::move(entity);
+void Level::_release(LevelData &data, Geometry &geometry) {
+	data = std::move(this->data);
 
-	return extracted;
+	geometry.tilesets = std::move(this->tilesets);
+
+	geometry.tile_kinds = std::move(this->tile_kinds);
+	geometry.tiles = std::move(this->tiles);
+	geometry.tile_count = this->tile_count;
+
+	geometry.collision_grid = std::move(this->collision_grid);
+
+	geometry.mesh_backlayer = std::move(this->mesh_backlayer);
+	geometry.mesh_tiles = std::move(this->mesh_tiles);
+	geometry.mesh_frontlayer = std::move(this->mesh_frontlayer);
+
+	geometry.mesh_tiles.unbind_animated_sprites(); // sprites belong to tile objects of this level
+}
+
+size_t Level::Geometry::memory() const {
+	const size_t vertexCount =
+		this->mesh_backlayer.vertex_count() + this->mesh_tiles.vertex_count() + this->mesh_frontlayer.vertex_count();
+
+	return
+		this->tiles.size() * sizeof(std::uint16_t) +
+		this->tile_kinds.size() * sizeof(TileKind) +
+		this->collision_grid.memory() +
+		vertexCount * sizeof(sf::Vertex);
 }
 
 void Level::_insertFromSpawnQueue() {
 	for (auto &&entity : this->_spawn_queue) {
 		this->_insertNewEntity(std::move(entity));
 	}
+
+	this->_spawn_queue.clear();
 }
 
 void Level::_insertNewEntity(std::unique_ptr<ntt::Entity> &&entity) {
 	const auto ptr = entity.get();
-	this->entities.push_back(std::move(entity));
 
-	if (ptr->solid) this->entities_solid.insert(ptr);
-	if (ptr->solid && ptr->health) this->entities_killable.insert(ptr);
+	this->entities.insert(std::move(entity));
 
-	using Id = ntt::TypeId;
+	ptr->position_previous = ptr->position; // entity could have been moved after construction
 
-	// Add ptr to correct types (manually)
-	switch (ptr->type_id()) {
-	case Id::CREATURE:
-		this->entities_type[Id::CREATURE].insert(ptr);
-		break;
-	case Id::ENEMY:
-		this->entities_type[Id::CREATURE].insert(ptr);
-		this->entities_type[Id::ENEMY].insert(ptr);
-		break;
-	case Id::PLAYER:
-		this->entities_type[Id::CREATURE].insert(ptr);
-		this->player = dynamic_cast<ntt::player::Player*>(ptr);
-		break;
-	case Id::ITEM_ENTITY:
-		this->entities_type[Id::ITEM_ENTITY].insert(ptr);
-		break;
-	case Id::DESTRUCTIBLE:
-		this->entities_type[Id::DESTRUCTIBLE].insert(ptr);
-		break;
-	case Id::PROJECTILE:
-		this->entities_type[Id::PROJECTILE].insert(ptr);
-		break;
-	case Id::PARTICLE:
-		this->entities_type[Id::PARTICLE].insert(ptr);
-		break;
-	default:
-		break;
-	}
-}
-
-template<class Container, typename Condition>
-Container& swap_erase(Container &container, const Condition &condition) {
-	auto iterToLast = container.end();
-
-	for (auto iter = container.begin(); iter < iterToLast;)
-		if (condition(*iter)) *iter = std::move(*(--iterToLast));
-		else ++iter;
-
-	container.resize(iterToLast - container.begin());
-
-	return container;
+	if (ptr->type_id() == ntt::TypeId::PLAYER) this->player = dynamic_cast<ntt::player::Player*>(ptr);
 }
 
 void Level::_eraseMarkedEntities() {
-	auto iterToLast = this->entities.end();
-    
-    // TODO: Hmmm, it's almost as if there should be an appropriate algo somewhere in 'std'...
-    
-	for (auto iter = this->entities.begin(); iter < iterToLast;)
-		if (iter->get()->marked_for_erase()) {
-			const auto ptrToErase = iter->get();
-
-			// Move to the end
-            --iterToLast;
-            std::swap(*iter, *iterToLast);
-			//*iter = std::move(*(--iterToLast));
+	for (size_t i = 0; i < this->entities.size();) {
+		const auto entity = this->entities[i];
 
+		if (entity->marked_for_erase()) {
 			// Emit on-death flag (if present)
-			auto iterToEmitedFlag = this->_on_death_emits.find(ptrToErase);
+			if (const auto flag = this->entities.get_on_death_emit(entity->handle)) Flags::ACCESS->add(*flag);
 
-			if (iterToEmitedFlag != this->_on_death_emits.end()) {
-				Flags::ACCESS->add((*iterToEmitedFlag).second);
-				this->_on_death_emits.erase(iterToEmitedFlag);
-			}
+			if (entity->erase_delay() > 0.) ++this->delayed_erase_count;
 
-			// Clear dependencies
-			this->entities_solid.erase(ptrToErase);
-			this->entities_killable.erase(ptrToErase);
-			for (auto& node : this->entities_type) node.second.erase(ptrToErase);
+			this->entities.erase(entity->handle); // last entity gets moved into 'i'
 		}
 		else {
-			++iter;
+			++i;
 		}
+	}
+}
+
+void Level::_updatePhysics(Milliseconds elapsedTime) {
+	auto &list = this->_physics_list;
+
+	list.clear();
+
+	for (const auto entity : this->_update_list)
+		if (entity->physics_active()) list.push_back(entity);
 
-	this->entities.resize(iterToLast - this->entities.begin());
-	
-	/*const auto condition = [](ntt::Entity* ptr) { return ptr->marked_for_erase(); };
-	const auto condition2 = [](const std::unique_ptr<ntt::Entity> &ptr) { return ptr->marked_for_erase(); };
+	// Every task owns a contiguous slice, results don't depend on thread count or scheduling
+	const auto update_slice = [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) list[i]->solid->update(elapsedTime);
+	};
 
-	for (auto &node : this->entities_type) swap_erase(node.second, condition);
-	swap_erase(this->entities_solid, condition);
-	swap_erase(this->entities_killable, condition);
-	swap_erase(this->entities, condition2);*/
+	if (list.size() < performance::PARALLEL_PHYSICS_MIN_ENTITIES) update_slice(0, list.size());
+	else utl::parallel::for_loop(utl::parallel::IndexRange<size_t>(0, list.size()), update_slice);
 }
 
 // Tile
@@ -259,34 +339,45 @@ size_t Level::_getTile1DIndex(const Vector2 &index) const {
 	return index.x * this->map_size.y + index.y;
 }
 
-void Level::add_Tile(const Tileset &tileset, int id, const Vector2 position, const std::string &layerPrefix) {
-	auto newTile = tiles::make_tile(tileset, id, position * natural::TILE_SIZE);
-	const auto newTileIndex = this->_getTile1DIndex(position);
+void Level::add_Tile(const Tileset &tileset, int id, const Vector2 position, LevelData::TileLayer layer) {
+	const auto texture = tileset.tileset_get_texture();
+	const bool animated = tileset.has_tile_animation(id);
 
-	const static std::unordered_map<std::string, int> prefixToCase{
-		{"backlayer", 0},
-		{"layer", 1},
-		{"midlayer", 2},
-		{"frontlayer", 3}
-	};
+	// Logic layer tiles are patched by their objects upon drawing (see 'add_TileObject()')
+	if (layer == LevelData::TileLayer::LAYER) {
+		this->mesh_tiles.add_tile(position, texture, tileset.get_tile_source_rect(id), animated);
+		return;
+	}
 
-	switch (prefixToCase.at(layerPrefix)) {
-	case 0:
-		this->tiles_backlayer[newTileIndex] = std::move(newTile);
-		break;
-	case 1:
-		this->tiles[newTileIndex] = std::move(newTile);
-		break;
-	case 2:
-		this->tiles_midlayer[newTileIndex] = std::move(newTile);
+	// Decorative tiles are never updated, animated ones are baked at their first frame
+	const auto sourceRect = animated
+		? tileset.get_tile_animation(id).frame(0).rect
+		: tileset.get_tile_source_rect(id);
+
+	switch (layer) {
+	case LevelData::TileLayer::BACKLAYER:
+		this->mesh_backlayer.add_tile(position, texture, sourceRect);
 		break;
-	case 3:
-		this->tiles_frontlayer[newTileIndex] = std::move(newTile);
+	case LevelData::TileLayer::FRONTLAYER:
+		this->mesh_frontlayer.add_tile(position, texture, sourceRect);
 		break;
 	default:
 		break;
 	}
 }
+
+void Level::add_TileObject(const Tileset &tileset, int id, const Vector2 position) {
+	const bool animated = tileset.has_tile_animation(id);
+
+	// Logic layer tiles get an object only if there is something to update
+	if (!animated && !tileset.has_tile_interaction(id)) return;
+
+	auto newTile = tiles::make_tile(tileset, id, position * natural::TILE_SIZE);
+	if (animated) this->mesh_tiles.bind_animated_sprite(position, newTile->sprite.get());
+
+	this->tile_objects.push_back(std::move(newTile));
+}
+
 ntt::Entity* Level::add_Entity(const std::string &type, const std::string &name, Vector2d position) {
 	auto entity = ntt::m::make_entity(type, name, position);
 	const auto ptr = entity.get();
@@ -296,350 +387,155 @@ ntt::Entity* Level::add_Entity(const std::string &type, const std::string &name,
 	return ptr;
 }
 
-// Parsing
-void Level::parseFromJSON(const std::string &filePath) {
-	// Load JSON doc
-	std::ifstream ifStream(filePath);
-	nlohmann::json JSON = nlohmann::json::parse(ifStream);
+// Construction
+void Level::_buildGeometry() {
+	const auto &data = this->data;
 
-	// Parse map properties
-	for (const auto &property_node : JSON["properties"]) {
-		const std::string prefix = tags::get_prefix(property_node["name"].get<std::string>());
+	// Tilesets
+	// - gids are already resolved by level data, so tilesets are shared instead of copied
+	for (const auto &tilesetRef : data.tilesets)
+		this->tilesets.push_back(&TilesetStorage::ACCESS->getTileset(tilesetRef.name));
 
-		if (prefix == "background") {
-			this->background_sprite.setTexture(
-				Graphics::ACCESS->getTexture_Background(property_node["value"].get<std::string>())
-			);
-		}
-		if (prefix == "music") {
-			Audio::ACCESS->queue_music(property_node["value"].get<std::string>());
-		}
-		/// new properties go there
-	}
+	// Map size
+	this->map_size = data.size;
 
-	// Parse tilesets
-	const nlohmann::json &tilesets_array_node = JSON["tilesets"];
-	for (const auto &tileset_node : tilesets_array_node) {
-		// Extract tileset name
-		std::string fileName = tileset_node["source"].get<std::string>();
-		fileName = fileName.substr(fileName.rfind("/") + 1); // cut before '/'
-		fileName = fileName.substr(fileName.rfind("\\") + 1); // cut before '\'
+	this->tiles.assign(this->map_size.x * this->map_size.y, NO_TILE);
 
-		// Create tileset object and set firstgid
-		Tileset tileset = TilesetStorage::ACCESS->getTileset(fileName);
-		tileset.first_gid = tileset_node["firstgid"].get<int>(); // firstgid is map-dependant (that's also why we copy tilesets)
+	this->mesh_backlayer.init(this->map_size);
+	this->mesh_tiles.init(this->map_size);
+	this->mesh_frontlayer.init(this->map_size);
 
-		this->tilesets.push_back(std::move(tileset)); // save tileset
-	}
+	// Tiles
+	std::unordered_map<std::uint32_t, std::uint16_t> tileKindLookup; // '(tileset << 16) | id' -> index in 'tile_kinds'
 
-	// Parse map properties (size and etc)
-	this->map_size.x = JSON["width"].get<int>();
-	this->map_size.y = JSON["height"].get<int>();
+	for (size_t layerIndex = 0; layerIndex < LevelData::TILE_LAYER_COUNT; ++layerIndex) {
+		const auto &layer = data.layers[layerIndex];
+		const auto layerType = static_cast<LevelData::TileLayer>(layerIndex);
 
-	this->tiles_backlayer.resize(this->map_size.x * this->map_size.y);
-	this->tiles.resize(this->map_size.x * this->map_size.y);
-	this->tiles_midlayer.resize(this->map_size.x * this->map_size.y);
-	this->tiles_frontlayer.resize(this->map_size.x * this->map_size.y);
+		for (size_t i = 0; i < layer.size(); ++i) {
+			const auto &tile = layer[i];
 
-	// Parse tile layers
-	const nlohmann::json &layers_array_node = JSON["layers"];
-	for (const auto &layer_node : layers_array_node) {
-		const std::string layer_type = layer_node["type"].get<std::string>(); // can be "tilelayer" or "objectgroup"
+			if (tile.tileset >= this->tilesets.size()) continue; // empty cell
 
-		// Parse data depending on layer_type
-		if (layer_type == "tilelayer") {
-			this->parse_tilelayer(layer_node);
-		}
-		else if (layer_type == "objectgroup") {
-			this->parse_objectgroup(layer_node);
-		}
-	}
+			const Vector2 tilePosition(
+				static_cast<int>(i % this->map_size.x),
+				static_cast<int>(i / this->map_size.x)
+			);
 
-}
+			const Tileset &tileset = *this->tilesets[tile.tileset];
 
-void Level::parse_tilelayer(const nlohmann::json &tilelayer_node) {
-	// Determine layer type
-	const auto layerPrefix = tags::get_prefix(tilelayer_node["name"].get<std::string>());
+			this->add_Tile(tileset, tile.id, tilePosition, layerType);
 
-	int tileCount = 0; // used to determine tile position
+			// Logic layer cells reference shared tile kinds
+			if (layerType != LevelData::TileLayer::LAYER) continue;
 
-	const nlohmann::json &data_array_node = tilelayer_node["data"];
-	for (const auto &data_node : data_array_node) {
-		const int gid = data_node.get<int>();
+			const std::uint32_t key = (static_cast<std::uint32_t>(tile.tileset) << 16) | tile.id;
 
-		if (gid) { // if tile is present
-			// Calculate tile position
-			const Vector2 tilePosition(
-				(tileCount % this->map_size.x),
-				(tileCount / this->map_size.x)
-			);
+			auto kind = tileKindLookup.find(key);
+			if (kind == tileKindLookup.end()) {
+				if (this->tile_kinds.size() >= NO_TILE) {
+					UTL_LOG_ERR("Level {", this->levelName, "} uses too many distinct tiles");
+					continue;
+				}
 
-			// Determine which tileset tile belongs to (based on gid)
-			const Tileset* correspondingTileset = &this->tilesets.front();
-			for (const auto &tileset : this->tilesets)
-				if (gid >= tileset.first_gid) correspondingTileset = &tileset;
+				this->tile_kinds.push_back({ &tileset, tile.id, tileset.find_tile_hitbox(tile.id) });
+				kind = tileKindLookup.emplace(key, static_cast<std::uint16_t>(this->tile_kinds.size() - 1)).first;
+			}
 
-			const int tileId = gid - correspondingTileset->first_gid;
+			auto &cell = this->tiles[this->_getTile1DIndex(tilePosition)];
+			if (cell == NO_TILE) ++this->tile_count;
 
-			// Construct tile and add it to the level
-			this->add_Tile(*correspondingTileset, tileId, tilePosition, layerPrefix);
+			cell = kind->second;
 		}
-
-		++tileCount;
 	}
+
+	this->collision_grid.build(this->map_size, [&](int X, int Y) -> const TileHitbox* {
+		const auto kind = this->tiles[this->_getTile1DIndex(X, Y)];
+		return (kind != NO_TILE) ? this->tile_kinds[kind].hitbox : nullptr;
+	});
 }
 
-void Level::parse_objectgroup(const nlohmann::json &objectgroup_node) {
-	// get layer prefix and suffix
-	const std::string layer_prefix = tags::get_prefix(objectgroup_node["name"].get<std::string>());
-	const std::string layer_suffix = tags::get_suffix(objectgroup_node["name"].get<std::string>());
+void Level::_buildObjects() {
+	const auto &data = this->data;
 
-	if (layer_prefix == "entity") {
-		this->parse_objectgroup_entity(objectgroup_node);
-	}
-	else if (layer_prefix == "script") {
-		if (layer_suffix == "level_change") {
-			this->parse_objectgroup_script_levelChange(objectgroup_node);
-		}
-		else if (layer_suffix == "level_switch") {
-			this->parse_objectgroup_script_levelSwitch(objectgroup_node);
-		}
-		else if (layer_suffix == "portal") {
-			this->parse_objectgroup_script_portal(objectgroup_node);
-		}
-		else if (layer_suffix == "hint") {
-			this->parse_objectgroup_script_hint(objectgroup_node);
-		}
-		else if (layer_suffix == "checkpoint") {
-			this->parse_objectgroup_script_checkpoint(objectgroup_node);
-		}
-		// new script types go there
-	}
-}
+	// Map properties
+	if (!data.background.empty())
+		this->background_sprite.setTexture(Graphics::ACCESS->getTexture_Background(data.background));
 
-// Entity types parsing
-void Level::parse_objectgroup_entity(const nlohmann::json &objectgroup_node) {
-	const nlohmann::json &objects_array_node = objectgroup_node["objects"];
-	for (const auto& object_node : objects_array_node) {
-		// Get custom properties
-		Flag requires_flag = "";
-		Flag emits_flag = "";
+	this->music = data.music;
 
-		const auto properties_node_iter = object_node.find("properties");
+	if (!this->music.empty()) Audio::ACCESS->queue_music(this->music);
 
-		if (properties_node_iter != object_node.end()) {
-			const nlohmann::json &properties_array = *properties_node_iter;
+	// Flags decide which entities and scripts exist, so they are checked every time objects are built
+	const auto check_required_flag = [&](const Flag &flag) {
+		return flag.empty() || Flags::READ->check(flag);
+	};
 
-			for (const auto &property_node : properties_array) {
-				const std::string name = property_node["name"];
+	this->entities_grid.init(this->map_size);
 
-				if (name == "requires_flag") {
-					requires_flag = property_node["value"].get<std::string>();
-				}
-				else if (name == "emits_flag") {
-					emits_flag = property_node["value"].get<std::string>();
-				}
-			}
-		}
+	// Tile objects
+	const auto &logicLayer = data.layers[static_cast<size_t>(LevelData::TileLayer::LAYER)];
+
+	for (size_t i = 0; i < logicLayer.size(); ++i) {
+		const auto &tile = logicLayer[i];
+
+		if (tile.tileset >= this->tilesets.size()) continue; // empty cell
 
-		// If 'reqired_flag' is not satisfied, further parsing is unnecessary
-		if (!requires_flag.empty() && !Flags::READ->check(requires_flag)) continue;
+		const Vector2 tilePosition(
+			static_cast<int>(i % this->map_size.x),
+			static_cast<int>(i / this->map_size.x)
+		);
 
-		// Determine which tileset 'entity-tile' belongs to (based on gid)
-		const auto gid = object_node["gid"].get<int>();
-		
-		const Tileset* correspondingTileset = &this->tilesets.front();
+		this->add_TileObject(*this->tilesets[tile.tileset], tile.id, tilePosition);
+	}
 
-		for (const auto& tileset : this->tilesets)
-			if (gid >= tileset.first_gid) correspondingTileset = &tileset;
+	// Entities
+	for (const auto &entity : data.entities) {
+		// If 'reqired_flag' is not satisfied, entity isn't spawned
+		if (!check_required_flag(entity.requires_flag)) continue;
 
-		// Get spawn data
-		const int id = gid - correspondingTileset->first_gid;
-		const auto &enitySpawnData = correspondingTileset->get_entity_spawn_data(id);
+		if (entity.tile.tileset >= this->tilesets.size()) continue;
 
-		// Parse position
-		const auto tilePosition = Vector2d(object_node["x"].get<double>(), object_node["y"].get<double>());
+		const auto &enitySpawnData = this->tilesets[entity.tile.tileset]->get_entity_spawn_data(entity.tile.id);
 
-		// Create entity
 		const auto ptr_to_entity = this->add_Entity(
 			enitySpawnData.type,
 			enitySpawnData.name,
-			tilePosition + enitySpawnData.position_in_tile - Vector2d(0, natural::TILE_SIZE)
+			entity.position + enitySpawnData.position_in_tile - Vector2d(0, natural::TILE_SIZE)
 				// !!! for some bizarre reason Tiled uses BOTTOM-left corner coordinates for
 				// tile objects so we have to move it up 1 tile to get normal coords
 		);
 
 		// Set flag emited on death (if present)
-		if (!emits_flag.empty()) this->_on_death_emits[ptr_to_entity] = emits_flag;
-	}
-}
-
-// Scripts parsing
-void Level::parse_objectgroup_script_levelChange(const nlohmann::json &objectgroup_node) {
-	const nlohmann::json &objects_array_node = objectgroup_node["objects"];
-	for (const auto &object_node : objects_array_node) {
-		// Parse hitbox
-		const dRect hitbox = dRect(
-			object_node["x"].get<int>(), object_node["y"].get<int>(),
-			object_node["width"].get<int>(), object_node["height"].get<int>()
-		);
-
-		std::string goes_to_level;
-		Vector2 goes_to_pos;
-
-		// Parse custom properties
-		for (const auto &property_node : object_node["properties"]) {
-			const std::string prefix = tags::get_prefix(property_node["name"].get<std::string>());
-
-			if (prefix == "goes_to_level") {
-				goes_to_level = property_node["value"].get<std::string>();
-			}
-			else if (prefix == "goes_to_x") {
-				goes_to_pos.x = property_node["value"].get<int>();
-			}
-			else if (prefix == "goes_to_y") {
-				goes_to_pos.y = property_node["value"].get<int>();
-			}
-		}
-
-		this->scripts.insert(std::make_unique<scripts::LevelChange>(hitbox, goes_to_level, goes_to_pos));
-	}
-}
-
-void Level::parse_objectgroup_script_levelSwitch(const nlohmann::json &objectgroup_node) {
-	const nlohmann::json &objects_array_node = objectgroup_node["objects"];
-	for (const auto &object_node : objects_array_node) {
-		// Parse hitbox
-		const dRect hitbox = dRect(
-			object_node["x"].get<int>(), object_node["y"].get<int>(),
-			object_node["width"].get<int>(), object_node["height"].get<int>()
-		);
-
-		std::string goes_to_level;
-		Vector2 goes_to_pos;
-
-		// Parse custom properties
-		for (const auto &property_node : object_node["properties"]) {
-			const std::string prefix = tags::get_prefix(property_node["name"].get<std::string>());
-
-			if (prefix == "goes_to_level") {
-				goes_to_level = property_node["value"].get<std::string>();
-			}
-			else if (prefix == "goes_to_x") {
-				goes_to_pos.x = property_node["value"].get<int>();
-			}
-			else if (prefix == "goes_to_y") {
-				goes_to_pos.y = property_node["value"].get<int>();
-			}
-		}
-
-		this->scripts.insert(std::make_unique<scripts::LevelSwitch>(hitbox, goes_to_level, goes_to_pos));
+		if (!entity.emits_flag.empty()) this->entities.set_on_death_emit(ptr_to_entity->handle, entity.emits_flag);
 	}
-}
 
-void Level::parse_objectgroup_script_portal(const nlohmann::json &objectgroup_node) {
-	const nlohmann::json &objects_array_node = objectgroup_node["objects"];
-	for (const auto &object_node : objects_array_node) {
-		// Parse hitbox
-		const dRect hitbox = dRect(
-			object_node["x"].get<int>(), object_node["y"].get<int>(),
-			object_node["width"].get<int>(), object_node["height"].get<int>()
-		);
-
-		std::string goes_to_level;
-		Vector2 goes_to_pos;
-
-		// Parse custom properties
-		for (const auto &property_node : object_node["properties"]) {
-			const std::string prefix = tags::get_prefix(property_node["name"].get<std::string>());
-
-			if (prefix == "goes_to_x") {
-				goes_to_pos.x = property_node["value"].get<int>();
-			}
-			else if (prefix == "goes_to_y") {
-				goes_to_pos.y = property_node["value"].get<int>();
-			}
+	// Scripts
+	for (const auto &script : data.scripts) {
+		const dRect hitbox = dRect(script.x, script.y, script.width, script.height);
+
+		switch (script.type) {
+		case LevelData::ScriptType::LEVEL_CHANGE:
+			this->scripts.insert(std::make_unique<scripts::LevelChange>(hitbox, script.goes_to_level, script.goes_to_pos));
+			break;
+		case LevelData::ScriptType::LEVEL_SWITCH:
+			this->scripts.insert(std::make_unique<scripts::LevelSwitch>(hitbox, script.goes_to_level, script.goes_to_pos));
+			break;
+		case LevelData::ScriptType::PORTAL:
+			this->scripts.insert(std::make_unique<scripts::Portal>(hitbox, script.goes_to_pos));
+			break;
+		case LevelData::ScriptType::HINT:
+			this->scripts.insert(std::make_unique<scripts::Hint>(hitbox, dRect(script.text_center, script.text_size, true), script.text));
+			break;
+		case LevelData::ScriptType::CHECKPOINT:
+			// If 'reqired_flag' is not satisfied, checkpoint isn't created
+			if (!check_required_flag(script.requires_flag)) break;
+
+			this->scripts.insert(std::make_unique<scripts::Checkpoint>(hitbox, script.emits_flag));
+			break;
+		default: // new script types go there
+			break;
 		}
-
-		this->scripts.insert(std::make_unique<scripts::Portal>(hitbox, goes_to_pos));
-	}
-}
-
-void Level::parse_objectgroup_script_hint(const nlohmann::json &objectgroup_node) {
-	const nlohmann::json &objects_array_node = objectgroup_node["objects"];
-	for (const auto &object_node : objects_array_node) {
-		// Parse hitbox
-		const dRect hitbox = dRect(
-			object_node["x"].get<int>(), object_node["y"].get<int>(),
-			object_node["width"].get<int>(), object_node["height"].get<int>()
-		);
-
-		Vector2d field_center;
-		Vector2d field_size;
-
-		std::string text;
-		
-		// Parse custom properties
-		for (const auto &property_node : object_node["properties"]) {
-			const std::string prefix = tags::get_prefix(property_node["name"].get<std::string>());
-
-			if (prefix == "text") {
-				text = property_node["value"].get<std::string>();
-			}
-			else if (prefix == "text_x") {
-				field_center.x = property_node["value"].get<int>();
-			}
-			else if (prefix == "text_y") {
-				field_center.y = property_node["value"].get<int>();
-			}
-			else if (prefix == "text_width") {
-				field_size.x = property_node["value"].get<int>();
-			}
-			else if (prefix == "text_height") {
-				field_size.y = property_node["value"].get<int>();
-			}
-		}
-
-		const auto text_field = dRect(field_center, field_size, true);
-
-		this->scripts.insert(std::make_unique<scripts::Hint>(hitbox, text_field, text));
-	}
-}
-
-void Level::parse_objectgroup_script_checkpoint(const nlohmann::json &objectgroup_node) {
-	const nlohmann::json &objects_array_node = objectgroup_node["objects"];
-	for (const auto &object_node : objects_array_node) {
-		// Parse hitbox
-		const dRect hitbox = dRect(
-			object_node["x"].get<int>(), object_node["y"].get<int>(),
-			object_node["width"].get<int>(), object_node["height"].get<int>()
-		);
-
-		// Get custom properties
-		Flag requires_flag = "";
-		Flag emits_flag = "";
-
-		const auto properties_node_iter = object_node.find("properties");
-
-		if (properties_node_iter != object_node.end()) {
-			const nlohmann::json &properties_array = *properties_node_iter;
-
-			for (const auto &property_node : properties_array) {
-				const std::string name = property_node["name"];
-
-				if (name == "requires_flag") {
-					requires_flag = property_node["value"].get<std::string>();
-				}
-				else if (name == "emits_flag") {
-					emits_flag = property_node["value"].get<std::string>();
-				}
-			}
-		}
-
-		// If 'reqired_flag' is not satisfied, further parsing is unnecessary
-		if (!requires_flag.empty() && !Flags::READ->check(requires_flag)) continue;
-
-		this->scripts.insert(std::make_unique<scripts::Checkpoint>(hitbox, emits_flag));
 	}
 }
 //void Level::parse_objectgroup_script_PlayerInArea(const nlohmann::json &objectgroup_node) {
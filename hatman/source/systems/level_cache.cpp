@@ -0,0 +1,90 @@
+#include "systems/level_cache.h"
+
+
+
+// # LevelCache #
+namespace LevelCache_consts {
+	constexpr size_t RECORD_MEMORY_ESTIMATE = 128; // entity/script record with its strings
+}
+
+static size_t approximate_memory(const LevelData &data, const Level::Geometry &geometry) {
+	using namespace LevelCache_consts;
+
+	size_t memory = geometry.memory();
+
+	for (const auto &layer : data.layers) memory += layer.size() * sizeof(LevelData::TileRef);
+
+	memory += (data.entities.size() + data.scripts.size()) * RECORD_MEMORY_ESTIMATE;
+
+	return memory;
+}
+
+LevelCache::LevelCache(size_t memoryBudget) :
+	memory_used(0),
+	memory_budget(memoryBudget)
+{}
+
+void LevelCache::store(std::unique_ptr<Level> &&level) {
+	if (!level) return;
+
+	Entry entry;
+	entry.name = level->getName();
+	level->_release(entry.data, entry.geometry);
+	level.reset(); // entities and other runtime state are dropped
+
+	entry.memory = approximate_memory(entry.data, entry.geometry);
+
+	if (entry.memory > this->memory_budget) return; // level is destroyed
+
+	// Replace older version of the same level (if present)
+	for (auto it = this->entries.begin(); it != this->entries.end(); ++it)
+		if (it->name == entry.name) {
+			this->memory_used -= it->memory;
+			this->entries.erase(it);
+			break;
+		}
+
+	this->memory_used += entry.memory;
+	this->entries.push_front(std::move(entry));
+
+	// Evict least recently used levels
+	while (this->memory_used > this->memory_budget) {
+		this->memory_used -= this->entries.back().memory;
+		this->entries.pop_back();
+	}
+}
+
+std::unique_ptr<Level> LevelCache::take(const std::string &name, std::unique_ptr<ntt::Entity> &&player) {
+	for (auto it = this->entries.begin(); it != this->entries.end(); ++it) {
+		if (it->name != name) continue;
+
+		auto level = std::make_unique<Level>(name, std::move(it->data), std::move(it->geometry), std::move(player));
+
+		this->memory_used -= it->memory;
+		this->entries.erase(it);
+
+		return level;
+	}
+
+	return nullptr;
+}
+
+bool LevelCache::contains(const std::string &name) const {
+	for (const auto &entry : this->entries)
+		if (entry.name == name) return true;
+
+	return false;
+}
+
+void LevelCache::clear() {
+	this->entries.clear();
+	this->memory_used = 0;
+}
+
+size_t LevelCache::size() const {
+	return this->entries.size();
+}
+
+size_t LevelCache::memory() const {
+	return this->memory_used;
+}
@@ -0,0 +1,382 @@
+#include "systems/level_data.h"
+
+#include <algorithm> // 'equal()'
+#include <filesystem> // checking if compiled level is up to date
+#include <fstream> // reading/writing files
+#include <unordered_map> // layer name lookup
+
+#include "thirdparty/nlohmann.hpp" // parsing from JSON
+#include "utility/binary_io.hpp" // binary I/O helpers
+#include "utility/tags.h" // tag utility
+
+
+
+// Compiled level format ('.hlvl')
+// - Header: magic "HLVL", format version
+// - Background and music names, map size
+// - Tilesets: name and firstgid of every tileset
+// - Layers: presence byte for each of 'TILE_LAYER_COUNT' layers, followed by a raw 'TileRef' array if present
+// - Entity records, script records
+namespace level_format {
+	using namespace binary_io;
+
+	constexpr char MAGIC[4] = { 'H', 'L', 'V', 'L' };
+	constexpr std::uint32_t VERSION = 1;
+
+	const std::string JSON_EXTENSION = ".json";
+	const std::string BINARY_EXTENSION = ".hlvl";
+
+	constexpr long long MAX_MAP_TILES = 1 << 24; // far above any real or generated map, guards allocations against corrupted sizes
+
+	bool valid_size(const Vector2 &size) {
+		return size.x > 0 && size.y > 0 && static_cast<long long>(size.x) * size.y <= MAX_MAP_TILES;
+	}
+}
+
+
+
+// # LevelData #
+bool LevelData::load(const std::string &jsonPath) {
+	const std::string binaryPath = LevelData::binaryPath(jsonPath);
+
+	std::error_code error;
+	const bool binaryPresent = std::filesystem::exists(binaryPath, error);
+	const bool jsonPresent = std::filesystem::exists(jsonPath, error);
+
+	const bool binaryUpToDate = binaryPresent &&
+		(!jsonPresent || std::filesystem::last_write_time(binaryPath, error) >= std::filesystem::last_write_time(jsonPath, error));
+		// level edited after compilation => compiled version is ignored until 'hatman_levelc' is run again
+
+	if (binaryUpToDate) {
+		if (this->loadFromBinary(binaryPath)) return true;
+		*this = LevelData(); // discard partially read data
+	}
+
+	return this->parseFromJSON(jsonPath);
+}
+
+bool LevelData::parseFromJSON(const std::string &filePath) {
+	// Load JSON doc
+	std::ifstream ifStream(filePath);
+	if (!ifStream) return false;
+
+	nlohmann::json JSON = nlohmann::json::parse(ifStream);
+
+	// Parse map properties
+	for (const auto &property_node : JSON["properties"]) {
+		const std::string prefix = tags::get_prefix(property_node["name"].get<std::string>());
+
+		if (prefix == "background") this->background = property_node["value"].get<std::string>();
+		else if (prefix == "music") this->music = property_node["value"].get<std::string>();
+		/// new properties go there
+	}
+
+	// Parse tilesets
+	for (const auto &tileset_node : JSON["tilesets"]) {
+		// Extract tileset name
+		std::string fileName = tileset_node["source"].get<std::string>();
+		fileName = fileName.substr(fileName.rfind("/") + 1); // cut before '/'
+		fileName = fileName.substr(fileName.rfind("\\") + 1); // cut before '\'
+
+		this->tilesets.push_back({ fileName, tileset_node["firstgid"].get<int>() });
+	}
+
+	// Parse map size
+	this->size.x = JSON["width"].get<int>();
+	this->size.y = JSON["height"].get<int>();
+
+	if (!level_format::valid_size(this->size)) return false;
+
+	// Gid -> (tileset, id), resolved once here instead of per tile at load
+	const auto resolve_gid = [&](int gid) {
+		TileRef tile;
+
+		if (!gid || this->tilesets.empty()) return tile;
+
+		std::uint16_t tilesetIndex = 0;
+		for (std::uint16_t i = 0; i < this->tilesets.size(); ++i)
+			if (gid >= this->tilesets[i].first_gid) tilesetIndex = i;
+
+		tile.tileset = tilesetIndex;
+		tile.id = static_cast<std::uint16_t>(gid - this->tilesets[tilesetIndex].first_gid);
+		return tile;
+	};
+
+	// Parse layers
+	const static std::unordered_map<std::string, TileLayer> prefixToLayer{
+		{"backlayer", TileLayer::BACKLAYER},
+		{"layer", TileLayer::LAYER},
+		{"midlayer", TileLayer::MIDLAYER},
+		{"frontlayer", TileLayer::FRONTLAYER}
+	};
+
+	const auto parse_hitbox = [](const nlohmann::json &object_node, ScriptRecord &script) {
+		script.x = object_node["x"].get<int>();
+		script.y = object_node["y"].get<int>();
+		script.width = object_node["width"].get<int>();
+		script.height = object_node["height"].get<int>();
+	};
+
+	const auto parse_flags = [](const nlohmann::json &object_node, std::string &requiresFlag, std::string &emitsFlag) {
+		const auto properties_node_iter = object_node.find("properties");
+		if (properties_node_iter == object_node.end()) return;
+
+		for (const auto &property_node : *properties_node_iter) {
+			const std::string name = property_node["name"];
+
+			if (name == "requires_flag") requiresFlag = property_node["value"].get<std::string>();
+			else if (name == "emits_flag") emitsFlag = property_node["value"].get<std::string>();
+		}
+	};
+
+	for (const auto &layer_node : JSON["layers"]) {
+		const std::string layer_type = layer_node["type"].get<std::string>(); // can be "tilelayer" or "objectgroup"
+		const std::string layer_name = layer_node["name"].get<std::string>();
+		const std::string layer_prefix = tags::get_prefix(layer_name);
+		const std::string layer_suffix = tags::get_suffix(layer_name);
+
+		// Tile layers
+		if (layer_type == "tilelayer") {
+			const auto layerIter = prefixToLayer.find(layer_prefix);
+			if (layerIter == prefixToLayer.end()) continue;
+
+			const size_t mapTileCount = static_cast<size_t>(this->size.x) * this->size.y;
+
+			auto &layer = this->layers[static_cast<size_t>(layerIter->second)];
+			layer.resize(mapTileCount);
+
+			size_t tileCount = 0;
+			for (const auto &data_node : layer_node["data"]) {
+				if (tileCount >= mapTileCount) return false; // layer data doesn't fit the map, same as '.hlvl' check
+
+				const auto tile = resolve_gid(data_node.get<int>());
+				if (tile.tileset != NO_TILESET) layer[tileCount] = tile; // repeated layers are merged
+
+				++tileCount;
+			}
+		}
+		// Entities
+		else if (layer_type == "objectgroup" && layer_prefix == "entity") {
+			for (const auto &object_node : layer_node["objects"]) {
+				EntityRecord entity;
+
+				entity.tile = resolve_gid(object_node["gid"].get<int>());
+				entity.position = Vector2d(object_node["x"].get<double>(), object_node["y"].get<double>());
+				parse_flags(object_node, entity.requires_flag, entity.emits_flag);
+
+				this->entities.push_back(std::move(entity));
+			}
+		}
+		// Scripts
+		else if (layer_type == "objectgroup" && layer_prefix == "script") {
+			ScriptType type;
+
+			if (layer_suffix == "level_change") type = ScriptType::LEVEL_CHANGE;
+			else if (layer_suffix == "level_switch") type = ScriptType::LEVEL_SWITCH;
+			else if (layer_suffix == "portal") type = ScriptType::PORTAL;
+			else if (layer_suffix == "hint") type = ScriptType::HINT;
+			else if (layer_suffix == "checkpoint") type = ScriptType::CHECKPOINT;
+			else continue; // new script types go there
+
+			for (const auto &object_node : layer_node["objects"]) {
+				ScriptRecord script;
+				script.type = type;
+
+				parse_hitbox(object_node, script);
+
+				if (type == ScriptType::CHECKPOINT) {
+					parse_flags(object_node, script.requires_flag, script.emits_flag);
+				}
+				else if (object_node.find("properties") != object_node.end()) {
+					for (const auto &property_node : object_node["properties"]) {
+						const std::string prefix = tags::get_prefix(property_node["name"].get<std::string>());
+						const auto &value = property_node["value"];
+
+						if (prefix == "goes_to_level") script.goes_to_level = value.get<std::string>();
+						else if (prefix == "goes_to_x") script.goes_to_pos.x = value.get<int>();
+						else if (prefix == "goes_to_y") script.goes_to_pos.y = value.get<int>();
+						else if (prefix == "text") script.text = value.get<std::string>();
+						else if (prefix == "text_x") script.text_center.x = value.get<int>();
+						else if (prefix == "text_y") script.text_center.y = value.get<int>();
+						else if (prefix == "text_width") script.text_size.x = value.get<int>();
+						else if (prefix == "text_height") script.text_size.y = value.get<int>();
+					}
+				}
+
+				this->scripts.push_back(std::move(script));
+			}
+		}
+	}
+
+	return true;
+}
+
+bool LevelData::loadFromBinary(const std::string &filePath) {
+	using namespace level_format;
+
+	// Read the whole file at once
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+	if (!file) return false;
+
+	std::vector<char> buffer(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(buffer.data(), buffer.size())) return false;
+
+	BinaryReader reader(buffer);
+
+	// Header
+	char magic[sizeof(MAGIC)];
+	std::uint32_t version = 0;
+
+	for (auto &c : magic) reader.read(c);
+	reader.read(version);
+
+	if (!reader.ok() || !std::equal(magic, magic + sizeof(magic), MAGIC) || version != VERSION) return false;
+
+	// Map
+	reader.read_string(this->background);
+	reader.read_string(this->music);
+	reader.read(this->size.x);
+	reader.read(this->size.y);
+
+	if (!reader.ok() || !valid_size(this->size)) return false;
+
+	// Tilesets
+	std::uint32_t tilesetCount = 0;
+	reader.read(tilesetCount);
+
+	if (tilesetCount > reader.remaining()) return false; // every record takes at least a byte
+	this->tilesets.resize(tilesetCount);
+	for (auto &tileset : this->tilesets) {
+		reader.read_string(tileset.name);
+		reader.read(tileset.first_gid);
+	}
+
+	// Layers
+	for (auto &layer : this->layers) {
+		std::uint8_t present = 0;
+		reader.read(present);
+
+		if (present) reader.read_array(layer);
+	}
+
+	// Entities
+	std::uint32_t entityCount = 0;
+	reader.read(entityCount);
+
+	if (entityCount > reader.remaining()) return false; // every record takes at least a byte
+	this->entities.resize(entityCount);
+	for (auto &entity : this->entities) {
+		reader.read(entity.tile);
+		reader.read(entity.position.x);
+		reader.read(entity.position.y);
+		reader.read_string(entity.requires_flag);
+		reader.read_string(entity.emits_flag);
+	}
+
+	// Scripts
+	std::uint32_t scriptCount = 0;
+	reader.read(scriptCount);
+
+	if (scriptCount > reader.remaining()) return false; // every record takes at least a byte
+	this->scripts.resize(scriptCount);
+	for (auto &script : this->scripts) {
+		reader.read(script.type);
+		reader.read(script.x);
+		reader.read(script.y);
+		reader.read(script.width);
+		reader.read(script.height);
+		reader.read_string(script.goes_to_level);
+		reader.read(script.goes_to_pos.x);
+		reader.read(script.goes_to_pos.y);
+		reader.read_string(script.text);
+		reader.read(script.text_center.x);
+		reader.read(script.text_center.y);
+		reader.read(script.text_size.x);
+		reader.read(script.text_size.y);
+		reader.read_string(script.requires_flag);
+		reader.read_string(script.emits_flag);
+	}
+
+	// Validate
+	if (!reader.ok() || !reader.at_end()) return false;
+
+	const auto tileCount = static_cast<size_t>(this->size.x) * this->size.y;
+
+	for (const auto &layer : this->layers)
+		if (!layer.empty() && layer.size() != tileCount) return false;
+
+	return true;
+}
+
+bool LevelData::saveToBinary(const std::string &filePath) const {
+	using namespace level_format;
+
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file) return false;
+
+	// Header
+	file.write(MAGIC, sizeof(MAGIC));
+	write_value(file, VERSION);
+
+	// Map
+	write_string(file, this->background);
+	write_string(file, this->music);
+	write_value(file, this->size.x);
+	write_value(file, this->size.y);
+
+	// Tilesets
+	write_value(file, static_cast<std::uint32_t>(this->tilesets.size()));
+	for (const auto &tileset : this->tilesets) {
+		write_string(file, tileset.name);
+		write_value(file, tileset.first_gid);
+	}
+
+	// Layers
+	for (const auto &layer : this->layers) {
+		write_value(file, static_cast<std::uint8_t>(!layer.empty()));
+		if (!layer.empty()) write_array(file, layer);
+	}
+
+	// Entities
+	write_value(file, static_cast<std::uint32_t>(this->entities.size()));
+	for (const auto &entity : this->entities) {
+		write_value(file, entity.tile);
+		write_value(file, entity.position.x);
+		write_value(file, entity.position.y);
+		write_string(file, entity.requires_flag);
+		write_string(file, entity.emits_flag);
+	}
+
+	// Scripts
+	write_value(file, static_cast<std::uint32_t>(this->scripts.size()));
+	for (const auto &script : this->scripts) {
+		write_value(file, script.type);
+		write_value(file, script.x);
+		write_value(file, script.y);
+		write_value(file, script.width);
+		write_value(file, script.height);
+		write_string(file, script.goes_to_level);
+		write_value(file, script.goes_to_pos.x);
+		write_value(file, script.goes_to_pos.y);
+		write_string(file, script.text);
+		write_value(file, script.text_center.x);
+		write_value(file, script.text_center.y);
+		write_value(file, script.text_size.x);
+		write_value(file, script.text_size.y);
+		write_string(file, script.requires_flag);
+		write_string(file, script.emits_flag);
+	}
+
+	return file.good();
+}
+
+std::string LevelData::binaryPath(const std::string &jsonPath) {
+	using namespace level_format;
+
+	const bool hasJsonExtension =
+		jsonPath.size() >= JSON_EXTENSION.size() &&
+		jsonPath.compare(jsonPath.size() - JSON_EXTENSION.size(), JSON_EXTENSION.size(), JSON_EXTENSION) == 0;
+
+	return (hasJsonExtension ? jsonPath.substr(0, jsonPath.size() - JSON_EXTENSION.size()) : jsonPath) + BINARY_EXTENSION;
+}
@@ -0,0 +1,239 @@
+#include "systems/particles.h"
+
+#include <cmath> // 'floor()'
+
+#include "graphics/graphics.h" // access to rendering and texture atlas
+#include "systems/game.h" // access to level tiles
+#include "utility/globalconsts.hpp" // physical consts, tile size
+
+
+
+// # ParticleSystem #
+namespace ParticleSystem_consts {
+	constexpr size_t CAPACITY = 4096;
+
+	constexpr auto SIZE = Vector2d(3., 3.);
+	constexpr double FRICTION = 0.4;
+
+	const std::string TEXTURE = "[particle]{on_death_particle}/default.png";
+}
+
+ParticleSystem::ParticleSystem() :
+	particle_count(0),
+	vertices(sf::Quads)
+{
+	using namespace ParticleSystem_consts;
+
+	this->position_x.resize(CAPACITY);
+	this->position_y.resize(CAPACITY);
+	this->previous_x.resize(CAPACITY);
+	this->previous_y.resize(CAPACITY);
+	this->speed_x.resize(CAPACITY);
+	this->speed_y.resize(CAPACITY);
+	this->lifetime_left.resize(CAPACITY);
+	this->color.resize(CAPACITY);
+	this->grounded.resize(CAPACITY);
+
+	this->vertices.resize(CAPACITY * 4);
+
+	this->texture_region = Graphics::ACCESS->getTextureRegion_Entity(TEXTURE);
+}
+
+void ParticleSystem::emit(const Vector2d &position, const Vector2d &speed, const RGBColor &color, Milliseconds lifetime) {
+	if (this->particle_count == ParticleSystem_consts::CAPACITY) return;
+
+	const size_t i = this->particle_count++;
+
+	this->position_x[i] = position.x;
+	this->position_y[i] = position.y;
+	this->previous_x[i] = position.x; // particle doesn't move before its first step
+	this->previous_y[i] = position.y;
+	this->speed_x[i] = speed.x;
+	this->speed_y[i] = speed.y;
+	this->lifetime_left[i] = lifetime;
+	this->color[i] = sf::Color(color.r, color.g, color.b, color.alpha);
+	this->grounded[i] = false;
+}
+
+void ParticleSystem::update(Milliseconds elapsedTime) {
+	using namespace ParticleSystem_consts;
+
+	const double t = ms_to_sec(elapsedTime);
+	const double levelWidth = Game::READ->level->getSizeX() * natural::TILE_SIZE;
+	const double levelHeight = Game::READ->level->getSizeY() * natural::TILE_SIZE;
+
+	// Save positions for interpolation
+	for (size_t i = 0; i < this->particle_count; ++i) {
+		this->previous_x[i] = this->position_x[i];
+		this->previous_y[i] = this->position_y[i];
+	}
+
+	for (size_t i = 0; i < this->particle_count;) {
+		// Lifetime
+		this->lifetime_left[i] -= elapsedTime;
+
+		if (this->lifetime_left[i] < 0. || this->position_y[i] > levelHeight) {
+			this->_kill(i);
+			continue; // last particle was moved into 'i'
+		}
+
+		// Settled particles skip physics, nothing can disturb them (tiles are static, entities don't interact)
+		if (this->grounded[i] && this->speed_x[i] == 0.) {
+			++i;
+			continue;
+		}
+
+		// Friction (same model as 'SolidRectangle', mass cancels out)
+		double accelerationX = 0.;
+
+		if (this->grounded[i] && this->speed_x[i] != 0.) {
+			accelerationX = -helpers::sign(this->speed_x[i]) * physics::GRAVITY_ACCELERATION * FRICTION;
+
+			const int oldSpeedXSign = helpers::sign(this->speed_x[i]);
+			this->speed_x[i] += accelerationX * t;
+			if (helpers::sign(this->speed_x[i]) != oldSpeedXSign) this->speed_x[i] = 0.;
+		}
+
+		// Gravity
+		const double accelerationY = physics::GRAVITY_ACCELERATION;
+
+		this->speed_y[i] += accelerationY * t;
+
+		// Movement
+		const double movementX = this->speed_x[i] * t + accelerationX * t * t * 0.5;
+		const double movementY = this->speed_y[i] * t + accelerationY * t * t * 0.5;
+
+		this->_resolve_TileCollisions(i, movementX, movementY);
+
+		// Level borders
+		if (this->position_x[i] < SIZE.x / 2.) {
+			this->position_x[i] = SIZE.x / 2.;
+			this->speed_x[i] = 0.;
+		}
+		else if (this->position_x[i] > levelWidth - SIZE.x / 2.) {
+			this->position_x[i] = levelWidth - SIZE.x / 2.;
+			this->speed_x[i] = 0.;
+		}
+
+		++i;
+	}
+}
+
+void ParticleSystem::draw() {
+	using namespace ParticleSystem_consts;
+
+	if (!this->particle_count) return;
+
+	const auto &rect = this->texture_region.rect;
+
+	const float texLeft = static_cast<float>(rect.x);
+	const float texTop = static_cast<float>(rect.y);
+	const float texRight = static_cast<float>(rect.x + rect.w);
+	const float texBottom = static_cast<float>(rect.y + rect.h);
+
+	const float scaling_factor = static_cast<float>(Graphics::READ->scaling_factor());
+
+	const double alpha = Game::READ->interpolation_alpha();
+
+	this->vertices.resize(this->particle_count * 4);
+
+	for (size_t i = 0; i < this->particle_count; ++i) {
+		// Particles are centered, position is interpolated and snapped same way as for entity sprites
+		const double x = this->previous_x[i] + (this->position_x[i] - this->previous_x[i]) * alpha;
+		const double y = this->previous_y[i] + (this->position_y[i] - this->previous_y[i]) * alpha;
+
+		const float left = std::floor(static_cast<float>(x - SIZE.x / 2.) + .5f / scaling_factor);
+		const float top = std::floor(static_cast<float>(y - SIZE.y / 2.) + .5f / scaling_factor);
+		const float right = left + static_cast<float>(rect.w);
+		const float bottom = top + static_cast<float>(rect.h);
+
+		sf::Vertex* quad = &this->vertices[i * 4];
+
+		quad[0] = sf::Vertex(sf::Vector2f(left, top), this->color[i], sf::Vector2f(texLeft, texTop));
+		quad[1] = sf::Vertex(sf::Vector2f(right, top), this->color[i], sf::Vector2f(texRight, texTop));
+		quad[2] = sf::Vertex(sf::Vector2f(right, bottom), this->color[i], sf::Vector2f(texRight, texBottom));
+		quad[3] = sf::Vertex(sf::Vector2f(left, bottom), this->color[i], sf::Vector2f(texLeft, texBottom));
+	}
+
+	Graphics::ACCESS->camera->draw_vertices(this->vertices, this->texture_region.texture);
+}
+
+size_t ParticleSystem::count() const {
+	return this->particle_count;
+}
+
+void ParticleSystem::clear() {
+	this->particle_count = 0;
+}
+
+void ParticleSystem::_kill(size_t index) {
+	const size_t last = --this->particle_count;
+
+	this->position_x[index] = this->position_x[last];
+	this->position_y[index] = this->position_y[last];
+	this->previous_x[index] = this->previous_x[last];
+	this->previous_y[index] = this->previous_y[last];
+	this->speed_x[index] = this->speed_x[last];
+	this->speed_y[index] = this->speed_y[last];
+	this->lifetime_left[index] = this->lifetime_left[last];
+	this->color[index] = this->color[last];
+	this->grounded[index] = this->grounded[last];
+}
+
+void ParticleSystem::_resolve_TileCollisions(size_t index, double movementX, double movementY) {
+	using namespace ParticleSystem_consts;
+
+	const auto &level = Game::READ->level;
+
+	dRect rect(Vector2d(this->position_x[index], this->position_y[index]), SIZE, true);
+
+	// Particles are much smaller than tiles, so only cells touched by the rect need to be checked
+	const auto for_each_hitbox_rect = [&](auto &&callback) {
+		const int leftBound = std::max(static_cast<int>(std::floor(rect.getLeft() / natural::TILE_SIZE)), 0);
+		const int rightBound = std::min(static_cast<int>(std::floor(rect.getRight() / natural::TILE_SIZE)), level->getSizeX() - 1);
+		const int upperBound = std::max(static_cast<int>(std::floor(rect.getTop() / natural::TILE_SIZE)), 0);
+		const int lowerBound = std::min(static_cast<int>(std::floor(rect.getBottom() / natural::TILE_SIZE)), level->getSizeY() - 1);
+
+		for (int X = leftBound; X <= rightBound; ++X)
+			for (int Y = upperBound; Y <= lowerBound; ++Y)
+				level->collision_grid.for_each_rect(X, Y, [&](const TileHitboxRect &hitboxRect) {
+					if (rect.overlapsWithRect(hitboxRect.rect)) callback(hitboxRect);
+				});
+	};
+
+	// X-axis
+	rect.moveByX(movementX);
+
+	if (movementX != 0.) for_each_hitbox_rect([&](const TileHitboxRect &hitboxRect) {
+		if (hitboxRect.is_platform) return;
+
+		if (movementX > 0.) rect.moveRightTo(hitboxRect.rect.getLeft());
+		else rect.moveLeftTo(hitboxRect.rect.getRight());
+
+		this->speed_x[index] = 0.;
+	});
+
+	// Y-axis
+	rect.moveByY(movementY);
+
+	this->grounded[index] = false;
+
+	for_each_hitbox_rect([&](const TileHitboxRect &hitboxRect) {
+		if (movementY > 0.) {
+			if (!hitboxRect.is_platform || rect.getBottom() < hitboxRect.rect.getTop() + physics::PLATFORM_EPSILON) {
+				rect.moveBottomTo(hitboxRect.rect.getTop());
+				this->speed_y[index] = 0.;
+				this->grounded[index] = true;
+			}
+		}
+		else if (movementY < 0. && !hitboxRect.is_platform) {
+			rect.moveTopTo(hitboxRect.rect.getBottom());
+			this->speed_y[index] = 0.;
+		}
+	});
+
+	const Vector2d center = rect.getCenter();
+
+	this->position_x[index] = center.x;
+	this->position_y[index] = center.y;
+}
@@ -0,0 +1,127 @@
+#include "systems/profiler.h"
+
+#include <fstream> // writing traces
+
+
+
+// # FrameProfiler #
+FrameProfiler& FrameProfiler::get() {
+	static FrameProfiler instance;
+
+	return instance;
+}
+
+FrameProfiler::FrameProfiler() :
+	enabled(false),
+	frame_open(false),
+	origin(clock::now()),
+	frames(FRAME_CAPACITY),
+	frame_count(0),
+	current_frame(FRAME_CAPACITY - 1)
+{}
+
+void FrameProfiler::set_enabled(bool enabled) {
+	if (enabled && !this->enabled) {
+		this->frame_count = 0;
+		this->current_frame = FRAME_CAPACITY - 1;
+		this->zone_stack.clear();
+	}
+
+	this->enabled = enabled;
+	this->frame_open = false;
+}
+
+bool FrameProfiler::is_enabled() const {
+	return this->enabled;
+}
+
+void FrameProfiler::begin_frame() {
+	if (!this->enabled) return;
+
+	this->current_frame = (this->current_frame + 1) % FRAME_CAPACITY;
+	if (this->frame_count < FRAME_CAPACITY) ++this->frame_count;
+
+	auto &frame = this->frames[this->current_frame];
+	frame.begin = this->_now();
+	frame.end = frame.begin - 1; // marks frame as unfinished
+	frame.events.clear(); // keeps capacity, so recording stops allocating once the buffer went around
+
+	this->zone_stack.clear();
+	this->frame_open = true;
+}
+
+void FrameProfiler::end_frame() {
+	if (!this->enabled || !this->frame_open) return;
+
+	this->frames[this->current_frame].end = this->_now();
+	this->frame_open = false;
+}
+
+bool FrameProfiler::begin_zone(const char* name) {
+	if (!this->enabled || !this->frame_open) return false;
+
+	auto &events = this->frames[this->current_frame].events;
+
+	const std::int64_t now = this->_now();
+	events.push_back(Event{ name, now, now - 1, static_cast<std::uint32_t>(this->zone_stack.size()) });
+
+	this->zone_stack.push_back(events.size() - 1);
+
+	return true;
+}
+
+void FrameProfiler::end_zone() {
+	if (!this->enabled || !this->frame_open || this->zone_stack.empty()) return;
+
+	this->frames[this->current_frame].events[this->zone_stack.back()].end = this->_now();
+	this->zone_stack.pop_back();
+}
+
+bool FrameProfiler::dump_chrome_trace(const std::string &filePath) const {
+	std::ofstream file(filePath);
+	if (!file) return false;
+
+	// Trace event format: complete events ("ph":"X") with timestamps and durations in microseconds
+	bool first = true;
+
+	const auto write_event = [&](const char* name, std::int64_t begin, std::int64_t end, std::uint32_t depth) {
+		if (end < begin) return; // zone or frame didn't finish before recording stopped
+
+		file
+			<< (first ? "\n" : ",\n")
+			<< "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+			<< ",\"ts\":" << begin / 1000. << ",\"dur\":" << (end - begin) / 1000.
+			<< ",\"args\":{\"depth\":" << depth << "}}";
+
+		first = false;
+	};
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	for (size_t k = 0; k < this->frame_count; ++k) {
+		const auto &frame = this->frames[(this->current_frame + FRAME_CAPACITY - this->frame_count + 1 + k) % FRAME_CAPACITY];
+
+		write_event("Frame", frame.begin, frame.end, 0);
+
+		for (const auto &event : frame.events) write_event(event.name, event.begin, event.end, event.depth + 1);
+	}
+
+	file << "\n]}\n";
+
+	return static_cast<bool>(file);
+}
+
+std::int64_t FrameProfiler::_now() const {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - this->origin).count();
+}
+
+
+
+// # FrameProfiler::Zone #
+FrameProfiler::Zone::Zone(const char* name) :
+	active(FrameProfiler::get().begin_zone(name))
+{}
+
+FrameProfiler::Zone::~Zone() {
+	if (this->active) FrameProfiler::get().end_zone();
+}
@@ -0,0 +1,259 @@
+#include "systems/replay.h"
+
+#include <algorithm> // 'equal()'
+#include <cstdio> // 'remove()'
+#include <iterator> // 'istreambuf_iterator' (reading whole file)
+
+#include "utility/binary_io.hpp" // binary I/O helpers
+
+
+
+// Binary format
+namespace replay_format {
+	using namespace binary_io;
+
+	constexpr char MAGIC[4] = { 'H', 'R', 'P', 'L' };
+	constexpr std::uint32_t VERSION = 2; // 2 - added state checksums
+
+	// Bits of the per-step mask
+	constexpr std::uint8_t ELAPSED_TIME = 1 << 0;
+	constexpr std::uint8_t MOUSE_POSITION = 1 << 1;
+	constexpr std::uint8_t KEYS_PRESSED = 1 << 2;
+	constexpr std::uint8_t KEYS_HELD = 1 << 3;
+	constexpr std::uint8_t KEYS_RELEASED = 1 << 4;
+	constexpr std::uint8_t BUTTONS_PRESSED = 1 << 5;
+	constexpr std::uint8_t BUTTONS_HELD = 1 << 6;
+	constexpr std::uint8_t BUTTONS_RELEASED = 1 << 7;
+
+	template<size_t N>
+	void write_bits(std::ostream &stream, const std::bitset<N> &bits) {
+		for (size_t byteIndex = 0; byteIndex < (N + 7) / 8; ++byteIndex) {
+			std::uint8_t byte = 0;
+
+			for (size_t bit = 0; bit < 8 && byteIndex * 8 + bit < N; ++bit)
+				if (bits[byteIndex * 8 + bit]) byte |= (1 << bit);
+
+			write_value(stream, byte);
+		}
+	}
+
+	template<size_t N>
+	bool read_bits(std::istream &stream, std::bitset<N> &bits) {
+		for (size_t byteIndex = 0; byteIndex < (N + 7) / 8; ++byteIndex) {
+			std::uint8_t byte;
+			if (!read_value(stream, byte)) return false;
+
+			for (size_t bit = 0; bit < 8 && byteIndex * 8 + bit < N; ++bit)
+				bits[byteIndex * 8 + bit] = (byte >> bit) & 1;
+		}
+
+		return true;
+	}
+}
+
+
+
+// # InputRecorder #
+InputRecorder::InputRecorder(const std::string &filePath, std::uint32_t seed, const std::string &saveFilePath) :
+	file(filePath, std::ios::binary),
+	previous_elapsed_time(-1.), // first step always records elapsed time
+	steps(0)
+{
+	using namespace replay_format;
+
+	// Snapshot save file
+	std::ifstream saveFile(saveFilePath, std::ios::binary);
+	const std::uint8_t savePresent = saveFile.good();
+	const std::string saveContents = savePresent ?
+		std::string(std::istreambuf_iterator<char>(saveFile), std::istreambuf_iterator<char>()) :
+		std::string();
+
+	// Header
+	this->file.write(MAGIC, sizeof(MAGIC));
+	write_value(this->file, VERSION);
+	write_value(this->file, seed);
+	write_value(this->file, savePresent);
+	write_value(this->file, static_cast<std::uint32_t>(saveContents.size()));
+	this->file.write(saveContents.data(), saveContents.size());
+}
+
+bool InputRecorder::is_open() const {
+	return this->file.good();
+}
+
+void InputRecorder::write_step(const InputState &state, Milliseconds elapsedTime) {
+	using namespace replay_format;
+
+	const auto &prev = this->previous_state;
+
+	std::uint8_t mask = 0;
+
+	if (elapsedTime != this->previous_elapsed_time) mask |= ELAPSED_TIME;
+	if (state.mouse_position.x != prev.mouse_position.x || state.mouse_position.y != prev.mouse_position.y) mask |= MOUSE_POSITION;
+	if (state.keys_pressed != prev.keys_pressed) mask |= KEYS_PRESSED;
+	if (state.keys_held != prev.keys_held) mask |= KEYS_HELD;
+	if (state.keys_released != prev.keys_released) mask |= KEYS_RELEASED;
+	if (state.buttons_pressed != prev.buttons_pressed) mask |= BUTTONS_PRESSED;
+	if (state.buttons_held != prev.buttons_held) mask |= BUTTONS_HELD;
+	if (state.buttons_released != prev.buttons_released) mask |= BUTTONS_RELEASED;
+
+	write_value(this->file, mask);
+
+	if (mask & ELAPSED_TIME) write_value(this->file, elapsedTime);
+	if (mask & MOUSE_POSITION) {
+		write_value(this->file, state.mouse_position.x);
+		write_value(this->file, state.mouse_position.y);
+	}
+	if (mask & KEYS_PRESSED) write_bits(this->file, state.keys_pressed);
+	if (mask & KEYS_HELD) write_bits(this->file, state.keys_held);
+	if (mask & KEYS_RELEASED) write_bits(this->file, state.keys_released);
+	if (mask & BUTTONS_PRESSED) write_bits(this->file, state.buttons_pressed);
+	if (mask & BUTTONS_HELD) write_bits(this->file, state.buttons_held);
+	if (mask & BUTTONS_RELEASED) write_bits(this->file, state.buttons_released);
+
+	this->previous_state = state;
+	this->previous_elapsed_time = elapsedTime;
+	++this->steps;
+}
+
+bool InputRecorder::checksum_due() const {
+	return this->steps && this->steps % replay_format::CHECKSUM_PERIOD == 0;
+}
+
+void InputRecorder::write_checksum(std::uint64_t checksum) {
+	binary_io::write_value(this->file, checksum);
+}
+
+size_t InputRecorder::step_count() const {
+	return this->steps;
+}
+
+
+
+// # InputReplay #
+InputReplay::InputReplay(const std::string &filePath) :
+	file(filePath, std::ios::binary),
+	rng_seed(0),
+	save_present(false),
+	current_elapsed_time(0.),
+	header_valid(false),
+	is_finished(true),
+	steps(0),
+	checksums(0),
+	divergent_step(0)
+{
+	using namespace replay_format;
+
+	char magic[sizeof(MAGIC)];
+	std::uint32_t version;
+	std::uint8_t savePresent;
+	std::uint32_t saveSize;
+
+	if (!this->file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)) return;
+	if (!read_value(this->file, version) || version != VERSION) return;
+	if (!read_value(this->file, this->rng_seed)) return;
+	if (!read_value(this->file, savePresent) || !read_value(this->file, saveSize)) return;
+
+	this->save_present = savePresent;
+	this->save_contents.resize(saveSize);
+	if (!this->file.read(this->save_contents.data(), saveSize)) return;
+
+	this->header_valid = true;
+	this->is_finished = false;
+}
+
+bool InputReplay::is_open() const {
+	return this->header_valid;
+}
+
+std::uint32_t InputReplay::seed() const {
+	return this->rng_seed;
+}
+
+void InputReplay::write_save(const std::string &saveFilePath) const {
+	if (!this->save_present) {
+		std::remove(saveFilePath.c_str()); // game starts without a save, same as during recording
+		return;
+	}
+
+	std::ofstream saveFile(saveFilePath, std::ios::binary);
+	saveFile.write(this->save_contents.data(), this->save_contents.size());
+}
+
+bool InputReplay::read_step(InputState &state, Milliseconds &elapsedTime) {
+	using namespace replay_format;
+
+	if (this->is_finished) return false;
+
+	std::uint8_t mask;
+	if (!read_value(this->file, mask)) {
+		this->is_finished = true;
+		return false;
+	}
+
+	bool ok = true;
+	auto &current = this->current_state;
+
+	if (mask & ELAPSED_TIME) ok = ok && read_value(this->file, this->current_elapsed_time);
+	if (mask & MOUSE_POSITION) {
+		ok = ok && read_value(this->file, current.mouse_position.x);
+		ok = ok && read_value(this->file, current.mouse_position.y);
+	}
+	if (mask & KEYS_PRESSED) ok = ok && read_bits(this->file, current.keys_pressed);
+	if (mask & KEYS_HELD) ok = ok && read_bits(this->file, current.keys_held);
+	if (mask & KEYS_RELEASED) ok = ok && read_bits(this->file, current.keys_released);
+	if (mask & BUTTONS_PRESSED) ok = ok && read_bits(this->file, current.buttons_pressed);
+	if (mask & BUTTONS_HELD) ok = ok && read_bits(this->file, current.buttons_held);
+	if (mask & BUTTONS_RELEASED) ok = ok && read_bits(this->file, current.buttons_released);
+
+	if (!ok) { // truncated record, recording was likely interrupted
+		this->is_finished = true;
+		return false;
+	}
+
+	state = current;
+	elapsedTime = this->current_elapsed_time;
+
+	++this->steps;
+
+	return true;
+}
+
+bool InputReplay::finished() const {
+	return this->is_finished;
+}
+
+bool InputReplay::checksum_due() const {
+	return this->steps && this->steps % replay_format::CHECKSUM_PERIOD == 0;
+}
+
+bool InputReplay::verify_checksum(std::uint64_t checksum) {
+	std::uint64_t recorded;
+	if (!binary_io::read_value(this->file, recorded)) { // truncated record, recording was likely interrupted
+		this->is_finished = true;
+		return true;
+	}
+
+	++this->checksums;
+
+	if (recorded == checksum) return true;
+
+	if (!this->divergent_step) this->divergent_step = this->steps;
+	return false;
+}
+
+size_t InputReplay::step_count() const {
+	return this->steps;
+}
+
+size_t InputReplay::checksums_verified() const {
+	return this->checksums;
+}
+
+bool InputReplay::diverged() const {
+	return this->divergent_step;
+}
+
+size_t InputReplay::first_divergent_step() const {
+	return this->divergent_step;
+}
@@ -0,0 +1,107 @@
+#include "systems/spatial_grid.h"
+
+#include <algorithm> // 'clamp()', 'max()'
+#include <cmath> // 'floor()', 'ceil()'
+
+#include "entity/base.h" // 'Entity' type
+
+
+
+// # SpatialGrid #
+void SpatialGrid::init(const Vector2 &mapSize) {
+	this->size_x = std::max(static_cast<int>(std::ceil(mapSize.x * natural::TILE_SIZE / CELL_SIZE)), 1);
+	this->size_y = std::max(static_cast<int>(std::ceil(mapSize.y * natural::TILE_SIZE / CELL_SIZE)), 1);
+
+	this->entries.clear();
+	this->cell_begin.assign(static_cast<size_t>(this->size_x) * this->size_y + 1, 0);
+	this->cell_entries.clear();
+	this->relocated.clear();
+}
+
+void SpatialGrid::rebuild(const std::vector<ntt::Entity*> &entities) {
+	const size_t cellCount = static_cast<size_t>(this->size_x) * this->size_y;
+
+	// Compute cell ranges
+	this->entries.clear();
+	this->relocated.clear();
+
+	if (!cellCount) return; // grid wasn't initialized
+
+	for (const auto &entity : entities) {
+		const dRect hitbox = entity->solid->getHitbox();
+
+		this->entries.push_back(Entry{
+			entity,
+			this->_cellX(hitbox.getLeft()),
+			this->_cellY(hitbox.getTop()),
+			this->_cellX(hitbox.getRight()),
+			this->_cellY(hitbox.getBottom()),
+			false
+		});
+	}
+
+	// Count entries per cell
+	this->cell_begin.assign(cellCount + 1, 0);
+
+	for (const auto &entry : this->entries)
+		for (int X = entry.cellLeft; X <= entry.cellRight; ++X)
+			for (int Y = entry.cellTop; Y <= entry.cellBottom; ++Y)
+				++this->cell_begin[this->_cellIndex(X, Y)];
+
+	for (size_t i = 1; i <= cellCount; ++i) this->cell_begin[i] += this->cell_begin[i - 1];
+		// now 'cell_begin[i]' points to the end of cell 'i'
+
+	// Fill cells back-to-front, which leaves 'cell_begin[i]' pointing to the beginning of cell 'i'
+	this->cell_entries.resize(this->cell_begin[cellCount]);
+
+	for (size_t i = 0; i < this->entries.size(); ++i) {
+		const auto &entry = this->entries[i];
+
+		for (int X = entry.cellLeft; X <= entry.cellRight; ++X)
+			for (int Y = entry.cellTop; Y <= entry.cellBottom; ++Y)
+				this->cell_entries[--this->cell_begin[this->_cellIndex(X, Y)]] = i;
+	}
+}
+
+void SpatialGrid::relocate(const ntt::Entity* entity) {
+	// Linear search is fine, teleports happen a few times per level
+	for (size_t i = 0; i < this->entries.size(); ++i) {
+		auto &entry = this->entries[i];
+
+		if (entry.entity != entity) continue;
+
+		if (!entry.relocated) {
+			entry.relocated = true;
+			this->relocated.push_back(i);
+		}
+		return;
+	}
+}
+
+int SpatialGrid::_cellX(double x) const {
+	return std::clamp(static_cast<int>(std::floor(x / CELL_SIZE)), 0, this->size_x - 1);
+}
+
+int SpatialGrid::_cellY(double y) const {
+	return std::clamp(static_cast<int>(std::floor(y / CELL_SIZE)), 0, this->size_y - 1);
+}
+
+size_t SpatialGrid::_cellIndex(int cellX, int cellY) const {
+	return static_cast<size_t>(cellY) * this->size_x + cellX; // row-major, neighbouring cells along X are adjacent
+}
+
+bool SpatialGrid::_overlaps_rect(const ntt::Entity* entity, const dRect &area) {
+	return area.overlapsWithRect(entity->solid->getHitbox());
+}
+
+bool SpatialGrid::_overlaps_circle(const ntt::Entity* entity, const Vector2d &center, double radius) {
+	const dRect hitbox = entity->solid->getHitbox();
+
+	// Distance from center to the closest point of a hitbox
+	const Vector2d closestPoint(
+		std::clamp(center.x, hitbox.getLeft(), hitbox.getRight()),
+		std::clamp(center.y, hitbox.getTop(), hitbox.getBottom())
+	);
+
+	return (closestPoint - center).length2() <= radius * radius;
+}
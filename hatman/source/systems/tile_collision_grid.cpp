@@ -0,0 +1,57 @@
+#include "systems/tile_collision_grid.h"
+
+
+
+// # TileCollisionGrid #
+void TileCollisionGrid::build(const Vector2 &mapSize, const std::function<const TileHitbox*(int, int)> &getHitbox) {
+	const size_t cellCount = static_cast<size_t>(mapSize.x) * mapSize.y;
+
+	this->size_y = mapSize.y;
+
+	this->masks.assign(cellCount, EMPTY);
+	this->cell_begin.assign(cellCount + 1, 0);
+	this->rects.clear();
+
+	// Cells are visited in storage order, so rects of each cell end up contiguous
+	for (int X = 0; X < mapSize.x; ++X)
+		for (int Y = 0; Y < mapSize.y; ++Y) {
+			const size_t cell = this->_cellIndex(X, Y);
+
+			this->cell_begin[cell] = static_cast<std::uint32_t>(this->rects.size());
+
+			const auto hitbox = getHitbox(X, Y);
+			if (!hitbox || hitbox->rectangles.empty()) continue;
+
+			const auto &first = hitbox->rectangles.front();
+
+			const bool isFull =
+				hitbox->rectangles.size() == 1 && !first.is_platform &&
+				first.rect.getLeft() == 0. && first.rect.getTop() == 0. &&
+				first.rect.getRight() == natural::TILE_SIZE && first.rect.getBottom() == natural::TILE_SIZE;
+
+			if (isFull) {
+				this->masks[cell] = SOLID | FULL;
+				continue;
+			}
+
+			const Vector2d offset(X * natural::TILE_SIZE, Y * natural::TILE_SIZE);
+
+			for (auto hitboxRect : hitbox->rectangles) {
+				hitboxRect.rect.moveBy(offset);
+				this->rects.push_back(hitboxRect);
+
+				this->masks[cell] |= hitboxRect.is_platform ? PLATFORM : SOLID;
+			}
+		}
+
+	this->cell_begin[cellCount] = static_cast<std::uint32_t>(this->rects.size());
+
+	this->rects.shrink_to_fit();
+}
+
+size_t TileCollisionGrid::memory() const {
+	return
+		this->masks.size() * sizeof(std::uint8_t) +
+		this->cell_begin.size() * sizeof(std::uint32_t) +
+		this->rects.size() * sizeof(TileHitboxRect);
+}
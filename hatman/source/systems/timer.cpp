@@ -1,37 +1,64 @@
 #include "systems/timer.h"
 
+#include <utility> // 'swap()'
+
 
 
 // # Timer #
+namespace Timer_consts {
+	constexpr size_t NOT_SCHEDULED = std::numeric_limits<size_t>::max();
+}
+
 Timer::Timer() :
 	timer_duration(-1), // not 0 to avoid nasty result during 'elapsed/duration' division for uninitialized timers
 	time_elapsed(0),
-	is_finished(true)
+	start_time(0),
+	is_finished(true),
+	heap_index(Timer_consts::NOT_SCHEDULED)
+{}
+
+Timer::Timer(const Timer &other) :
+	timer_duration(other.timer_duration),
+	time_elapsed(other.time_elapsed),
+	start_time(other.start_time),
+	is_finished(other.is_finished),
+	heap_index(Timer_consts::NOT_SCHEDULED)
 {
-	TimerController::ACCESS->timers.insert(this);
+	if (!this->is_finished) TimerController::ACCESS->_schedule(this);
 }
 
-Timer::~Timer() {
-	TimerController::ACCESS->timers.erase(this);
+Timer& Timer::operator=(const Timer &other) {
+	if (this == &other) return *this;
+
+	this->timer_duration = other.timer_duration;
+	this->time_elapsed = other.time_elapsed;
+	this->start_time = other.start_time;
+	this->is_finished = other.is_finished;
+
+	if (!this->is_finished) TimerController::ACCESS->_schedule(this);
+	else if (this->heap_index != Timer_consts::NOT_SCHEDULED) TimerController::ACCESS->_unschedule(this);
+
+	return *this;
 }
 
-void Timer::update(Milliseconds elapsedTime) {
-	if (!this->is_finished) {
-		if ((this->time_elapsed += elapsedTime) > this->timer_duration) {
-			this->is_finished = true;
-		}
-	}
+Timer::~Timer() {
+	if (this->heap_index != Timer_consts::NOT_SCHEDULED) TimerController::ACCESS->_unschedule(this);
 }
 
 void Timer::start(Milliseconds duration) {
 	this->timer_duration = duration;
 	this->time_elapsed = 0.;
+	this->start_time = TimerController::READ->now();
 	this->is_finished = false;
+
+	TimerController::ACCESS->_schedule(this);
 }
 
 void Timer::stop() {
 	this->time_elapsed = this->timer_duration;
 	this->is_finished = true;
+
+	if (this->heap_index != Timer_consts::NOT_SCHEDULED) TimerController::ACCESS->_unschedule(this);
 }
 
 bool Timer::finished() const {
@@ -39,7 +66,7 @@ bool Timer::finished() const {
 }
 
 Milliseconds Timer::elapsed() const {
-	return this->time_elapsed;
+	return this->is_finished ? this->time_elapsed : TimerController::READ->now() - this->start_time;
 }
 Milliseconds Timer::duration() const {
 	return this->timer_duration;
@@ -48,7 +75,11 @@ bool Timer::was_set() const {
 	return this->timer_duration > 0;
 }
 double Timer::elapsedPercentage() const {
-	return this->timer_duration ? this->time_elapsed / this->timer_duration : 1.;
+	return this->timer_duration ? this->elapsed() / this->timer_duration : 1.;
+}
+
+Milliseconds Timer::_deadline() const {
+	return this->start_time + this->timer_duration;
 }
 
 
@@ -57,13 +88,98 @@ double Timer::elapsedPercentage() const {
 const TimerController* TimerController::READ;
 TimerController* TimerController::ACCESS;
 
-TimerController::TimerController() {
+TimerController::TimerController() :
+	clock(0.)
+{
 	this->READ = this;
 	this->ACCESS = this;
 }
 
 void TimerController::update(Milliseconds elapsedTime) {
-	for (auto &timer : this->timers) {
-		timer->update(elapsedTime);
+	this->clock += elapsedTime;
+
+	// Finish all timers past their deadline, timer finishes once 'elapsed > duration'
+	while (!this->heap.empty() && this->clock - this->heap.front()->start_time > this->heap.front()->timer_duration) {
+		Timer* const timer = this->heap.front();
+
+		this->_unschedule(timer);
+
+		timer->time_elapsed = this->clock - timer->start_time; // freeze elapsed time
+		timer->is_finished = true;
+	}
+}
+
+Milliseconds TimerController::now() const {
+	return this->clock;
+}
+
+size_t TimerController::running_count() const {
+	return this->heap.size();
+}
+
+void TimerController::_schedule(Timer* timer) {
+	if (timer->heap_index == Timer_consts::NOT_SCHEDULED) {
+		timer->heap_index = this->heap.size();
+		this->heap.push_back(timer);
+		this->_sift_up(timer->heap_index);
 	}
-}
\ No newline at end of file
+	else {
+		// Deadline could have moved either way
+		this->_sift_up(timer->heap_index);
+		this->_sift_down(timer->heap_index);
+	}
+}
+
+void TimerController::_unschedule(Timer* timer) {
+	const size_t index = timer->heap_index;
+	const size_t last = this->heap.size() - 1;
+
+	if (index != last) {
+		this->_heap_swap(index, last);
+		this->heap.pop_back();
+
+		this->_sift_up(index);
+		this->_sift_down(index);
+	}
+	else {
+		this->heap.pop_back();
+	}
+
+	timer->heap_index = Timer_consts::NOT_SCHEDULED;
+}
+
+void TimerController::_sift_up(size_t index) {
+	while (index > 0) {
+		const size_t parent = (index - 1) / 2;
+
+		if (this->heap[parent]->_deadline() <= this->heap[index]->_deadline()) break;
+
+		this->_heap_swap(parent, index);
+		index = parent;
+	}
+}
+
+void TimerController::_sift_down(size_t index) {
+	const size_t size = this->heap.size();
+
+	while (true) {
+		const size_t left = 2 * index + 1;
+		const size_t right = left + 1;
+		size_t smallest = index;
+
+		if (left < size && this->heap[left]->_deadline() < this->heap[smallest]->_deadline()) smallest = left;
+		if (right < size && this->heap[right]->_deadline() < this->heap[smallest]->_deadline()) smallest = right;
+
+		if (smallest == index) break;
+
+		this->_heap_swap(index, smallest);
+		index = smallest;
+	}
+}
+
+void TimerController::_heap_swap(size_t index1, size_t index2) {
+	std::swap(this->heap[index1], this->heap[index2]);
+
+	this->heap[index1]->heap_index = index1;
+	this->heap[index2]->heap_index = index2;
+}
@@ -0,0 +1,492 @@
+// _______________________ INCLUDES _______________________
+
+// NOTE: CORRESPONDING HEADER
+
+// Includes: std
+#include <algorithm>   // 'sort()', 'max()', 'find_if()', 'find()'
+#include <chrono>      // measuring benchmark time
+#include <cstdint>     // fixed-size seed
+#include <filesystem>  // iterating over level directory
+#include <fstream>     // reading baseline, writing report
+#include <functional>  // 'function' type (benchmark bodies)
+#include <iomanip>     // 'setw()', 'setprecision()'
+#include <iostream>    // Text to console
+#include <iterator>    // 'begin()', 'end()' (argument list)
+#include <memory>      // 'unique_ptr' type
+#include <stdexcept>   // 'invalid_argument', 'out_of_range' (parsing arguments)
+#include <string>      // parsing arguments
+#include <type_traits> // 'is_floating_point_v' (parsing arguments)
+#include <vector>      // related type
+
+// Includes: dependencies
+#include "thirdparty/nlohmann.hpp" // JSON report and baseline
+
+// Includes: project
+#include "entity/player.h"          // 'Player' class
+#include "entity/unique_m.h"        // enemies for synthetic crowds
+#include "graphics/graphics.h"      // Has a storage (initialized before start)
+#include "modules/solid.h"          // 'SolidRectangle' class
+#include "modules/sprite.h"         // Has a storage (initialized before start)
+#include "objects/tile_base.h"      // Has a storage (initialized before start)
+#include "systems/audio.h"          // Has a storage (initialized before start)
+#include "systems/controls.h"       // Has a storage (initialized before start)
+#include "systems/emit.h"           // Has a storage (initialized before start)
+#include "systems/game.h"           // 'Game' class
+#include "systems/saver.h"          // Has a storage (initialized before start)
+#include "systems/timer.h"          // Has a storage (initialized before start)
+#include "utility/filepaths.hpp"    // level directory
+#include "utility/globalconsts.hpp" // natural resolution, timestep
+
+// ____________________ IMPLEMENTATION ____________________
+
+
+
+// Benchmark runner
+// - Usage: 'hatman_bench [--filter <text>] [--repeats <n>] [--level <name>] [--out <file>] [--baseline <file>] [--tolerance <fraction>]
+//   [--include-generated]'
+// - Runs with null graphics and audio backends, same as 'hatman_headless', run from the project root
+// - Every benchmark is run once as a warmup and then '--repeats' times, game RNG is reseeded before each run,
+//   so synthetic scenes are identical between runs and between builds
+// - Only the measured part of a run is timed, setup (spawning, placing, starting timers) is excluded
+// - Results are written as JSON ('bench_report.json' by default), passing a previous report as '--baseline'
+//   compares medians and exits with 1 if any benchmark got slower than the tolerance allows
+// - Micro-benchmarks: 'SolidRectangle::update' on a crowd, '_eraseMarkedEntities' under churn, 'TimerController::update'
+// - Macro-benchmarks: 'Level' load and build for every level, full 'Level::update' steps with spawned enemies
+// - Maps written by 'hatman_levelgen' are only loaded and built with '--include-generated', so reports of a plain run
+//   don't depend on what was generated locally, synthetic benchmarks can still use one through '--level generated/<name>'
+
+constexpr std::uint32_t SEED = 0;
+constexpr size_t DEFAULT_REPEATS = 5;
+constexpr double DEFAULT_TOLERANCE = 0.10; // 10% slower than baseline counts as a regression
+
+const std::string DEFAULT_LEVEL = "plains"; // level used as the scene of synthetic benchmarks
+const std::string DEFAULT_REPORT_FILEPATH = "bench_report.json";
+const std::string BENCH_SAVE_FILEPATH = "bench_save.json"; // never written, benchmarks don't touch the real save
+
+constexpr size_t SOLID_STEPS = 600; // 5 s of game time
+constexpr size_t SOLID_KICK_PERIOD = 120; // crowd is kicked every second, otherwise it falls asleep and measures nothing
+constexpr double SOLID_KICK_IMPULSE = 200.;
+
+constexpr size_t CHURN_ROUNDS = 50;
+
+constexpr size_t TIMER_STEPS = 1200; // 10 s of game time
+constexpr Milliseconds TIMER_MIN_DURATION = 100.;
+constexpr Milliseconds TIMER_MAX_DURATION = 5000.;
+
+constexpr size_t LEVEL_STEPS = 600;
+
+
+
+// Arguments
+const std::string USAGE =
+    "Usage: hatman_bench [--filter <text>] [--repeats <n>] [--level <name>] [--out <file>] [--baseline <file>] [--tolerance <fraction>] "
+    "[--include-generated]";
+
+const std::string ARGUMENTS[] = { "--filter", "--repeats", "--level", "--out", "--baseline", "--tolerance" }; // take a value
+
+template <class T>
+T parse_number(const std::string &str) {
+    // 'sto*()' throw on garbage, but silently accept trailing characters and wrap negative unsigned values
+    size_t parsed = 0;
+    T      result;
+
+    if constexpr (std::is_floating_point_v<T>) result = std::stod(str, &parsed);
+    else {
+        if (str.find('-') != std::string::npos) throw std::out_of_range("negative value");
+        result = static_cast<T>(std::stoull(str, &parsed));
+    }
+
+    if (parsed != str.size()) throw std::invalid_argument("trailing characters");
+
+    return result;
+}
+
+
+
+// Timing
+using clock_type = std::chrono::steady_clock;
+
+double elapsed_ms(clock_type::time_point start) {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+struct BenchResult {
+    std::string name;
+    size_t      repeats;
+    double      median_ms;
+    double      min_ms;
+    double      max_ms;
+};
+
+struct Benchmark {
+    std::string             name;
+    std::function<double()> run; // returns time of the measured part in ms
+};
+
+
+
+// Scene setup
+std::unique_ptr<Level> make_level(const std::string &name) {
+    const auto data   = Level::loadData(name);
+    const auto center = Vector2d(data.size.x, data.size.y) * natural::TILE_SIZE / 2.;
+
+    auto player = std::make_unique<ntt::player::Player>(center);
+    player->cameraTrap_center();
+
+    return std::make_unique<Level>(name, data, std::move(player));
+}
+
+Vector2d random_position_near(const Vector2d &center, const Vector2d &range) {
+    return center + Vector2d(rand_double(-range.x, range.x), rand_double(-range.y, range.y));
+}
+
+Vector2d update_range() {
+    // entities past freeze range don't update, so crowds are placed inside of it
+    return Vector2d(performance::ENTITY_FREEZE_RANGE_X, performance::ENTITY_FREEZE_RANGE_Y) * 0.9;
+}
+
+
+
+// Benchmarks
+double bench_level_load(const std::string &name) {
+    const auto start = clock_type::now();
+
+    const auto data = Level::loadData(name);
+
+    return elapsed_ms(start);
+}
+
+double bench_level_build(const std::string &name) {
+    auto data = Level::loadData(name);
+
+    const auto start = clock_type::now();
+
+    const Level level(name, std::move(data));
+
+    return elapsed_ms(start);
+}
+
+double bench_solid_update(Game &game, const std::string &levelName, size_t count) {
+    game.level = make_level(levelName);
+
+    const Vector2d center = game.level->player->position;
+
+    std::vector<Vector2d>       positions(count); // solids hold a reference, so storage is allocated upfront
+    std::vector<SolidRectangle> solids;
+    solids.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = random_position_near(center, update_range());
+        solids.emplace_back(positions[i], Vector2d(14., 14.), SolidFlags::SOLID | SolidFlags::AFFECTED_BY_GRAVITY, 1., 600.);
+    }
+
+    double total_ms = 0.;
+
+    for (size_t step = 0; step < SOLID_STEPS; ++step) {
+        if (step % SOLID_KICK_PERIOD == 0)
+            for (auto &solid : solids) solid.addImpulse(Vector2d(rand_double(-1., 1.), -1.) * SOLID_KICK_IMPULSE);
+
+        const auto start = clock_type::now();
+
+        for (auto &solid : solids) solid.update(performance::FIXED_TIMESTEP_MS);
+
+        total_ms += elapsed_ms(start);
+    }
+
+    game.level.reset();
+
+    return total_ms;
+}
+
+double bench_erase_churn(Game &game, const std::string &levelName, size_t count) {
+    game.level = make_level(levelName);
+
+    const Vector2d center = game.level->player->position;
+
+    // Every round refills the level up to 'count' entities and erases a random quarter of them
+    double total_ms = 0.;
+
+    for (size_t round = 0; round < CHURN_ROUNDS; ++round) {
+        for (size_t i = game.level->entities.size(); i < count; ++i)
+            game.level->spawn(std::make_unique<ntt::m::enemy::Sludge>(random_position_near(center, update_range())));
+
+        game.level->_insertFromSpawnQueue();
+
+        for (size_t i = 0; i < game.level->entities.size(); ++i) {
+            const auto entity = game.level->entities[i];
+            if (entity != game.level->player && rand_int(0, 3) == 0) entity->mark_for_erase();
+        }
+
+        const auto start = clock_type::now();
+
+        game.level->_eraseMarkedEntities();
+
+        total_ms += elapsed_ms(start);
+    }
+
+    game.level.reset();
+
+    return total_ms;
+}
+
+double bench_timer_update(size_t count) {
+    std::vector<Timer> timers(count);
+
+    for (auto &timer : timers) timer.start(rand_double(TIMER_MIN_DURATION, TIMER_MAX_DURATION));
+
+    // Finished timers are restarted, same as cooldowns that keep being used
+    double total_ms = 0.;
+
+    for (size_t step = 0; step < TIMER_STEPS; ++step) {
+        const auto start = clock_type::now();
+
+        TimerController::ACCESS->update(performance::FIXED_TIMESTEP_MS);
+
+        total_ms += elapsed_ms(start);
+
+        for (auto &timer : timers)
+            if (timer.finished()) timer.start(rand_double(TIMER_MIN_DURATION, TIMER_MAX_DURATION));
+    }
+
+    return total_ms;
+}
+
+double bench_level_update(Game &game, const std::string &levelName, size_t enemyCount) {
+    game.level = make_level(levelName);
+
+    const Vector2d center = game.level->player->position;
+
+    for (size_t i = 0; i < enemyCount; ++i)
+        game.level->spawn(std::make_unique<ntt::m::enemy::Sludge>(random_position_near(center, update_range())));
+
+    game.level->_insertFromSpawnQueue();
+
+    // Timers are updated along with the level, same as in 'Game::update_everything()'
+    const auto start = clock_type::now();
+
+    for (size_t step = 0; step < LEVEL_STEPS; ++step) {
+        game.level->update(performance::FIXED_TIMESTEP_MS);
+        TimerController::ACCESS->update(performance::FIXED_TIMESTEP_MS);
+    }
+
+    const double total_ms = elapsed_ms(start);
+
+    game.level.reset();
+
+    return total_ms;
+}
+
+
+
+// Running
+BenchResult run_benchmark(Game &game, const Benchmark &benchmark, size_t repeats) {
+    game.rng.seed(SEED);
+    benchmark.run(); // warmup, also fills tileset and texture caches
+
+    std::vector<double> times;
+
+    for (size_t i = 0; i < repeats; ++i) {
+        game.rng.seed(SEED);
+        times.push_back(benchmark.run());
+    }
+
+    std::sort(times.begin(), times.end());
+
+    return { benchmark.name, repeats, times[times.size() / 2], times.front(), times.back() };
+}
+
+bool write_report(const std::string &filepath, const std::vector<BenchResult> &results) {
+    nlohmann::json report;
+
+    report["seed"] = SEED;
+
+    for (const auto &result : results) {
+        report["benchmarks"].push_back({
+            { "name", result.name },
+            { "repeats", result.repeats },
+            { "median_ms", result.median_ms },
+            { "min_ms", result.min_ms },
+            { "max_ms", result.max_ms }
+        });
+    }
+
+    std::ofstream file(filepath);
+    file << std::setw(4) << report << "\n";
+
+    return static_cast<bool>(file);
+}
+
+int compare_to_baseline(const std::string &filepath, const std::vector<BenchResult> &results, double tolerance) {
+    std::ifstream file(filepath);
+
+    if (!file) {
+        std::cout << "Error: Could not read baseline '" << filepath << "'.\n";
+        return -1;
+    }
+
+    const nlohmann::json baseline = nlohmann::json::parse(file, nullptr, false);
+
+    if (baseline.is_discarded() || baseline.find("benchmarks") == baseline.end()) {
+        std::cout << "Error: Baseline '" << filepath << "' is not a benchmark report.\n";
+        return -1;
+    }
+
+    size_t regressions = 0;
+
+    std::cout << "\n- Comparison to '" << filepath << "' (tolerance " << tolerance * 100. << "%) -\n";
+
+    for (const auto &result : results) {
+        const auto &entries = baseline["benchmarks"];
+
+        const auto entry = std::find_if(entries.begin(), entries.end(), [&](const nlohmann::json &node) {
+            return node.value("name", "") == result.name;
+        });
+
+        std::cout << std::left << std::setw(40) << result.name;
+
+        if (entry == entries.end()) {
+            std::cout << "new\n";
+            continue;
+        }
+
+        const double baseline_ms = entry->value("median_ms", 0.);
+        const double change      = (baseline_ms > 0.) ? result.median_ms / baseline_ms - 1. : 0.;
+
+        const char* verdict = "";
+        if (change > tolerance) {
+            verdict = "  REGRESSION";
+            ++regressions;
+        }
+        else if (change < -tolerance) {
+            verdict = "  improved";
+        }
+
+        std::cout
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(12) << baseline_ms << " ms -> " << std::setw(12) << result.median_ms << " ms "
+            << std::showpos << std::setprecision(1) << std::setw(8) << change * 100. << "%" << std::noshowpos
+            << verdict << "\n";
+    }
+
+    std::cout << "Regressions: " << regressions << "\n";
+
+    return regressions ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    size_t      repeats           = DEFAULT_REPEATS;
+    std::string level_name        = DEFAULT_LEVEL;
+    std::string out_filepath      = DEFAULT_REPORT_FILEPATH;
+    std::string baseline_filepath;
+    double      tolerance         = DEFAULT_TOLERANCE;
+    bool        include_generated = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+
+        if (key == "--include-generated") {
+            include_generated = true;
+            continue;
+        }
+
+        if (std::find(std::begin(ARGUMENTS), std::end(ARGUMENTS), key) == std::end(ARGUMENTS)) {
+            std::cout << "Error: Unknown argument '" << key << "'.\n" << USAGE << "\n";
+            return -1;
+        }
+
+        if (i + 1 == argc) {
+            std::cout << "Error: Argument '" << key << "' requires a value.\n" << USAGE << "\n";
+            return -1;
+        }
+
+        const std::string value = argv[++i];
+
+        try {
+            if (key == "--filter") filter = value;
+            else if (key == "--repeats") repeats = std::max<size_t>(parse_number<size_t>(value), 1);
+            else if (key == "--level") level_name = value;
+            else if (key == "--out") out_filepath = value;
+            else if (key == "--baseline") baseline_filepath = value;
+            else if (key == "--tolerance") tolerance = parse_number<double>(value);
+        }
+        catch (const std::logic_error &) { // 'invalid_argument' or 'out_of_range'
+            std::cout << "Error: Invalid value '" << value << "' of argument '" << key << "'.\n" << USAGE << "\n";
+            return -1;
+        }
+    }
+
+    // Initialize all the storage objects (with null graphics and audio backends)
+    TimerController  timerController; // [!] timers must be created first
+    Graphics         graphics(natural::WIDTH, natural::HEIGHT, sf::Style::None);
+    Audio            audio(0, 0);
+    TilesetStorage   tilesets;
+    AnimationStorage animations;
+    EmitStorage      emits;
+    Flags            flags;
+    Saver            saver(BENCH_SAVE_FILEPATH);
+    Controls         controls;
+    Game             game(false);
+
+    // Collect benchmarks
+    std::vector<Benchmark> benchmarks;
+
+    std::vector<std::string> level_names;
+
+    const auto collect_levels = [&](const std::string &directory, const std::string &prefix) {
+        for (const auto &entry : std::filesystem::directory_iterator(directory))
+            if (entry.path().extension() == ".json") level_names.push_back(prefix + entry.path().stem().string());
+    };
+
+    collect_levels(PATH_LEVELS, ""); // not recursive, generated levels live in a subdirectory
+    if (include_generated && std::filesystem::is_directory(PATH_LEVELS_GENERATED)) collect_levels(PATH_LEVELS_GENERATED, "generated/");
+
+    std::sort(level_names.begin(), level_names.end()); // directory order isn't stable across platforms
+
+    for (const auto &name : level_names) {
+        benchmarks.push_back({ "level_load/" + name, [name] { return bench_level_load(name); } });
+        benchmarks.push_back({ "level_build/" + name, [name] { return bench_level_build(name); } });
+    }
+
+    for (size_t count : { 500, 2000 })
+        benchmarks.push_back({ "solid_update/crowd_" + std::to_string(count),
+            [&, count] { return bench_solid_update(game, level_name, count); } });
+
+    for (size_t count : { 200, 1000 })
+        benchmarks.push_back({ "erase_marked/churn_" + std::to_string(count),
+            [&, count] { return bench_erase_churn(game, level_name, count); } });
+
+    for (size_t count : { 1000, 10000 })
+        benchmarks.push_back({ "timer_update/timers_" + std::to_string(count),
+            [count] { return bench_timer_update(count); } });
+
+    for (size_t count : { 0, 50, 200 })
+        benchmarks.push_back({ "level_update/enemies_" + std::to_string(count),
+            [&, count] { return bench_level_update(game, level_name, count); } });
+
+    // Run
+    std::vector<BenchResult> results;
+
+    std::cout << "- Benchmarks (" << repeats << " repeats, seed " << SEED << ") -\n";
+
+    for (const auto &benchmark : benchmarks) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) continue;
+
+        results.push_back(run_benchmark(game, benchmark, repeats));
+
+        const auto &result = results.back();
+
+        std::cout
+            << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(3)
+            << "median " << std::setw(10) << result.median_ms << " ms   "
+            << "min " << std::setw(10) << result.min_ms << " ms   "
+            << "max " << std::setw(10) << result.max_ms << " ms\n";
+    }
+
+    if (write_report(out_filepath, results)) std::cout << "Report written to '" << out_filepath << "'\n";
+    else std::cout << "Error: Could not write report to '" << out_filepath << "'\n";
+
+    if (!baseline_filepath.empty()) return compare_to_baseline(baseline_filepath, results, tolerance);
+
+    return 0;
+}
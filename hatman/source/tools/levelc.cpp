@@ -0,0 +1,101 @@
+// _______________________ INCLUDES _______________________
+
+// NOTE: CORRESPONDING HEADER
+
+// Includes: std
+#include <chrono>     // measuring compilation time
+#include <filesystem> // iterating over level directory
+#include <iostream>   // Text to console
+#include <string>     // parsing arguments
+#include <vector>     // related type
+
+// Includes: dependencies
+#include "thirdparty/nlohmann.hpp" // catching JSON errors
+
+// Includes: project
+#include "systems/level_data.h" // 'LevelData' struct
+#include "utility/filepaths.hpp" // default level directory
+
+// ____________________ IMPLEMENTATION ____________________
+
+
+
+// Level compiler
+// - Usage: 'hatman_levelc [levels_directory] [--include-generated]'
+// - Compiles every Tiled JSON map in the directory ('content/levels/' by default) into a '.hlvl' binary
+//   placed next to it, game prefers compiled levels as long as they aren't older than their JSON
+// - Directory isn't searched recursively, so maps written by 'hatman_levelgen' into 'content/levels/generated/'
+//   are only compiled with '--include-generated' (or by passing that directory)
+// - Tilesets are referenced by name, their contents are still loaded from 'content/tilesets/'
+//   through 'TilesetStorage' which caches them for the whole session
+
+int main(int argc, char* argv[]) {
+    std::string directory;
+    bool        include_generated = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+
+        if (arg == "--include-generated") include_generated = true;
+        else if (directory.empty() && arg.rfind("--", 0) != 0) directory = arg;
+        else {
+            std::cout << "Error: Unknown argument '" << arg << "'.\n" << "Usage: hatman_levelc [levels_directory] [--include-generated]\n";
+            return -1;
+        }
+    }
+
+    if (directory.empty()) directory = PATH_LEVELS;
+
+    if (!std::filesystem::is_directory(directory)) {
+        std::cout << "Error: '" << directory << "' is not a directory.\n";
+        return -1;
+    }
+
+    std::vector<std::filesystem::path> paths;
+
+    for (const auto &entry : std::filesystem::directory_iterator(directory)) paths.push_back(entry.path());
+
+    const auto generated_directory = std::filesystem::path(directory) / "generated";
+    if (include_generated && std::filesystem::is_directory(generated_directory))
+        for (const auto &entry : std::filesystem::directory_iterator(generated_directory)) paths.push_back(entry.path());
+
+    size_t compiled = 0;
+    size_t failed   = 0;
+
+    for (const auto &path : paths) {
+        if (path.extension() != ".json") continue;
+
+        const std::string json_path   = path.string();
+        const std::string binary_path = LevelData::binaryPath(json_path);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        LevelData data;
+        bool      success = false;
+
+        try {
+            success = data.parseFromJSON(json_path) && data.saveToBinary(binary_path);
+        }
+        catch (const nlohmann::json::exception &e) {
+            std::cout << "Error: " << json_path << ": " << e.what() << "\n";
+        }
+
+        const double time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (success) {
+            std::cout
+                << json_path << " -> " << binary_path << " ("
+                << std::filesystem::file_size(json_path) << " B -> " << std::filesystem::file_size(binary_path) << " B, "
+                << time_ms << " ms)\n";
+            ++compiled;
+        }
+        else {
+            std::cout << "Error: Could not compile '" << json_path << "'.\n";
+            ++failed;
+        }
+    }
+
+    std::cout << "Compiled: " << compiled << ", failed: " << failed << "\n";
+
+    return failed ? -1 : 0;
+}
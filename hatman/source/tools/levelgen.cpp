@@ -0,0 +1,643 @@
+// _______________________ INCLUDES _______________________
+
+// NOTE: CORRESPONDING HEADER
+
+// Includes: std
+#include <algorithm>     // 'max()', 'min()', 'swap()', 'count()'
+#include <cmath>         // 'sqrt()', 'round()'
+#include <cstdint>       // fixed-size seed
+#include <filesystem>    // iterating over level directory, creating output directory
+#include <fstream>       // reading references, writing results
+#include <iostream>      // Text to console
+#include <map>           // related type (entity counts, ordered for stable output)
+#include <stdexcept>     // 'invalid_argument', 'out_of_range' (parsing arguments)
+#include <string>        // parsing arguments
+#include <unordered_map> // related type (tile catalog)
+#include <vector>        // related type
+
+// Includes: dependencies
+#include "firstparty/UTL/random.hpp" // 'Xoshiro256PP' (same sequence on every platform)
+#include "thirdparty/nlohmann.hpp"   // reading and writing Tiled JSON
+
+// Includes: project
+#include "utility/filepaths.hpp" // level and tileset directories
+#include "utility/tags.h"        // parsing '[prefix]{suffix}' object types
+
+// ____________________ IMPLEMENTATION ____________________
+
+
+
+// Stress level generator
+// - Usage: 'hatman_levelgen [--like <level>] [--scale <k>] [--width <n>] [--height <n>] [--density <fraction>]
+//   [--hitbox-rects <n>] [--entity <type-name>=<count>]... [--seed <n>] [--out <name>]', run from the project root
+// - Writes a Tiled-compatible map into 'content/levels/generated/<name>.json' ('stress' by default),
+//   loadable as level 'generated/<name>', tools skip this directory unless asked to include it
+// - Every written file is marked with a '[generated]' property, existing files without it are never overwritten,
+//   so shipped content can't be replaced by accident
+// - Generated map mirrors a reference level ('--like', by default the hand-made level with the most entities):
+//   same tilesets, background and music, logic/backlayer tiles are drawn from the reference with the same frequencies
+//   (so partial hitboxes and platforms appear as often as in real maps), same tile density and entity counts
+// - '--scale k' multiplies map area and entity counts by 'k', explicit '--width', '--height', '--density'
+//   and '--entity' override the scaled values ('<type-name>' is a key of 'ENTITY_MAKERS', like 'enemy-sludge')
+// - '--hitbox-rects n' slices every tile hitbox of the used tilesets into 'n' strips and writes those tilesets
+//   as '<tileset>_x<n>.json' next to the originals (the game looks tilesets up by name in a single directory),
+//   collision shapes stay the same while rect count grows 'n' times
+// - Logic layer is built from horizontal floor runs, leftover density is scattered, map border is solid,
+//   a spawn area in the center is kept empty ('hatman_bench --level <name>' puts the player there)
+// - Entities stand on top of solid cells when there is room, so they don't start inside of terrain
+
+constexpr std::uint64_t DEFAULT_SEED = 0;
+const std::string DEFAULT_OUT = "stress";
+
+constexpr int TILE_SIZE = 32;
+
+constexpr int FLOOR_SPACING = 6; // rows between floor runs
+constexpr int FLOOR_RUN_MIN = 4;
+constexpr int FLOOR_RUN_MAX = 16;
+constexpr int FLOOR_GAP_MIN = 2;
+constexpr int FLOOR_GAP_MAX = 6;
+
+constexpr int SPAWN_AREA_HALF_WIDTH = 4; // cells kept empty around the map center
+constexpr int SPAWN_AREA_HALF_HEIGHT = 3;
+
+using Random = utl::random::generators::Xoshiro256PP;
+
+int random_int(Random &random, int min, int max) { // in [min, max] range
+    return min + static_cast<int>(random() % static_cast<std::uint64_t>(max - min + 1));
+}
+
+template <typename T>
+const T& random_pick(Random &random, const std::vector<T> &values) {
+    return values[random() % values.size()];
+}
+
+
+
+// Reference level
+struct Reference {
+    std::string name;
+
+    int width  = 0;
+    int height = 0;
+
+    nlohmann::json properties = nlohmann::json::array();
+    nlohmann::json tilesets   = nlohmann::json::array();
+
+    std::vector<int> layer_palette; // every non-empty gid of a layer, so picking uniformly keeps frequencies
+    std::vector<int> backlayer_palette;
+    double           layer_density     = 0.;
+    double           backlayer_density = 0.;
+
+    std::vector<int> entity_gids;
+};
+
+nlohmann::json load_json(const std::string &filepath) {
+    std::ifstream file(filepath);
+    if (!file) return nlohmann::json();
+
+    return nlohmann::json::parse(file, nullptr, false);
+}
+
+std::string tileset_filename(const nlohmann::json &tileset_node) {
+    std::string fileName = tileset_node["source"].get<std::string>();
+    fileName = fileName.substr(fileName.rfind("/") + 1); // cut before '/'
+    fileName = fileName.substr(fileName.rfind("\\") + 1); // cut before '\'
+    return fileName;
+}
+
+bool is_generated(const nlohmann::json &node) { // works for both levels and tilesets
+    if (node.find("properties") == node.end()) return false;
+
+    for (const auto &property_node : node["properties"])
+        if (tags::get_prefix(property_node["name"].get<std::string>()) == "generated") return true;
+
+    return false;
+}
+
+nlohmann::json generated_property(const std::string &description) {
+    return {
+        { "name", "[generated]" },
+        { "type", "string" },
+        { "value", description }
+    };
+}
+
+bool can_overwrite(const std::string &filepath) { // only files written by this tool can be overwritten
+    if (!std::filesystem::exists(filepath)) return true;
+
+    const auto existing = load_json(filepath);
+    if (!existing.is_discarded() && !existing.is_null() && is_generated(existing)) return true;
+
+    std::cout << "Error: '" << filepath << "' already exists and isn't generated, refusing to overwrite it.\n";
+    return false;
+}
+
+size_t count_entities(const nlohmann::json &level) {
+    size_t count = 0;
+
+    for (const auto &layer_node : level["layers"])
+        if (layer_node["type"] == "objectgroup" && tags::get_prefix(layer_node["name"].get<std::string>()) == "entity")
+            count += layer_node["objects"].size();
+
+    return count;
+}
+
+std::string find_heaviest_level() {
+    std::string heaviest;
+    size_t      heaviest_entities = 0;
+
+    for (const auto &entry : std::filesystem::directory_iterator(PATH_LEVELS)) {
+        if (entry.path().extension() != ".json") continue;
+
+        const auto level = load_json(entry.path().string());
+        if (level.is_discarded() || level.is_null() || is_generated(level)) continue; // stress maps would reference themselves
+
+        const size_t entities = count_entities(level);
+
+        const std::string name = entry.path().stem().string();
+        if (heaviest.empty() || entities > heaviest_entities || (entities == heaviest_entities && name < heaviest)) {
+            heaviest          = name;
+            heaviest_entities = entities;
+        }
+    }
+
+    return heaviest;
+}
+
+bool load_reference(const std::string &name, Reference &reference) {
+    const auto level = load_json(PATH_LEVELS + name + ".json");
+    if (level.is_discarded() || level.is_null()) return false;
+
+    reference.name   = name;
+    reference.width  = level["width"].get<int>();
+    reference.height = level["height"].get<int>();
+
+    if (level.find("properties") != level.end())
+        for (const auto &property_node : level["properties"])
+            if (tags::get_prefix(property_node["name"].get<std::string>()) != "generated") reference.properties.push_back(property_node);
+    reference.tilesets = level["tilesets"];
+
+    const auto parse_palette = [&](const nlohmann::json &layer_node, std::vector<int> &palette, double &density) {
+        for (const auto &gid : layer_node["data"])
+            if (gid.get<int>()) palette.push_back(gid.get<int>());
+
+        density = static_cast<double>(palette.size()) / std::max<size_t>(layer_node["data"].size(), 1);
+    };
+
+    for (const auto &layer_node : level["layers"]) {
+        const std::string prefix = tags::get_prefix(layer_node["name"].get<std::string>());
+
+        if (layer_node["type"] == "tilelayer" && prefix == "layer")
+            parse_palette(layer_node, reference.layer_palette, reference.layer_density);
+        else if (layer_node["type"] == "tilelayer" && prefix == "backlayer")
+            parse_palette(layer_node, reference.backlayer_palette, reference.backlayer_density);
+        else if (layer_node["type"] == "objectgroup" && prefix == "entity")
+            for (const auto &object_node : layer_node["objects"]) reference.entity_gids.push_back(object_node["gid"].get<int>());
+    }
+
+    return !reference.layer_palette.empty();
+}
+
+
+
+// Tileset catalog
+struct Catalog {
+    std::unordered_map<int, bool>        gid_is_full;    // gids with a hitbox, true for a single full non-platform rect
+    std::map<std::string, int>           entity_gids;    // 'ENTITY_MAKERS' key -> gid
+    std::unordered_map<int, std::string> gid_entities;
+};
+
+bool is_full_hitbox(const nlohmann::json &objects_node) {
+    if (objects_node.size() != 1) return false;
+
+    const auto &object = objects_node[0];
+
+    for (const auto &property_node : object.value("properties", nlohmann::json::array()))
+        if (property_node["name"] == "is_platform" && property_node["value"].get<bool>()) return false;
+
+    return
+        object["x"].get<int>() == 0 && object["y"].get<int>() == 0 &&
+        object["width"].get<int>() == TILE_SIZE && object["height"].get<int>() == TILE_SIZE;
+}
+
+Catalog load_catalog(const Reference &reference) {
+    Catalog catalog;
+
+    for (const auto &tileset_node : reference.tilesets) {
+        const int  first_gid = tileset_node["firstgid"].get<int>();
+        const auto tileset   = load_json(PATH_TILESETS + tileset_filename(tileset_node));
+
+        if (tileset.is_discarded() || tileset.is_null() || tileset.find("tiles") == tileset.end()) continue;
+
+        for (const auto &tile_node : tileset["tiles"]) {
+            if (tile_node.find("objectgroup") == tile_node.end()) continue;
+
+            const int gid = first_gid + tile_node["id"].get<int>();
+
+            nlohmann::json hitbox_objects = nlohmann::json::array();
+
+            for (const auto &object : tile_node["objectgroup"]["objects"]) {
+                const std::string type = object["type"].get<std::string>();
+
+                if (tags::get_prefix(type) == "tile_hitbox") hitbox_objects.push_back(object);
+                else if (tags::get_prefix(type) == "entity") {
+                    std::string name;
+                    for (const auto &property_node : object.value("properties", nlohmann::json::array()))
+                        if (property_node["name"] == "[name]") name = property_node["value"].get<std::string>();
+
+                    const std::string key = tags::get_suffix(type) + "-" + name; // same key as 'ENTITY_MAKERS'
+
+                    catalog.entity_gids[key]   = gid;
+                    catalog.gid_entities[gid] = key;
+                }
+            }
+
+            if (!hitbox_objects.empty()) catalog.gid_is_full[gid] = is_full_hitbox(hitbox_objects);
+        }
+    }
+
+    return catalog;
+}
+
+bool write_sliced_tilesets(Reference &reference, int slices) {
+    // Tilesets keep their tile count and image, so gids in the map stay valid after changing 'source'
+    for (auto &tileset_node : reference.tilesets) {
+        const std::string fileName = tileset_filename(tileset_node);
+
+        auto tileset = load_json(PATH_TILESETS + fileName);
+        if (tileset.is_discarded() || tileset.is_null() || tileset.find("tiles") == tileset.end()) continue;
+
+        bool has_hitboxes = false;
+
+        for (auto &tile_node : tileset["tiles"]) {
+            if (tile_node.find("objectgroup") == tile_node.end()) continue;
+
+            auto &objects_node = tile_node["objectgroup"]["objects"];
+
+            nlohmann::json sliced = nlohmann::json::array();
+            int            next_id = 1;
+
+            for (const auto &object : objects_node) {
+                if (tags::get_prefix(object["type"].get<std::string>()) != "tile_hitbox") {
+                    sliced.push_back(object);
+                    sliced.back()["id"] = next_id++;
+                    continue;
+                }
+
+                has_hitboxes = true;
+
+                // Vertical strips, narrow rects get as many strips as they have pixels
+                const int x      = object["x"].get<int>();
+                const int width  = object["width"].get<int>();
+                const int strips = std::max(std::min(slices, width), 1);
+
+                for (int k = 0; k < strips; ++k) {
+                    const int left  = x + width * k / strips;
+                    const int right = x + width * (k + 1) / strips;
+
+                    auto strip     = object;
+                    strip["id"]    = next_id++;
+                    strip["x"]     = left;
+                    strip["width"] = right - left;
+
+                    sliced.push_back(strip);
+                }
+            }
+
+            objects_node = sliced;
+        }
+
+        if (!has_hitboxes) continue;
+
+        const std::string stem        = fileName.substr(0, fileName.rfind('.'));
+        const std::string sliced_name = stem + "_x" + std::to_string(slices) + ".json";
+
+        tileset["name"] = stem + "_x" + std::to_string(slices);
+
+        if (tileset.find("properties") == tileset.end()) tileset["properties"] = nlohmann::json::array();
+        tileset["properties"].push_back(generated_property("sliced " + fileName + " into " + std::to_string(slices)));
+
+        if (!can_overwrite(PATH_TILESETS + sliced_name)) return false;
+
+        std::ofstream file(PATH_TILESETS + sliced_name);
+        file << tileset.dump(1) << "\n";
+        if (!file) return false;
+
+        tileset_node["source"] = "../tilesets/" + sliced_name;
+
+        std::cout << "Tileset written to '" << PATH_TILESETS << sliced_name << "'\n";
+    }
+
+    return true;
+}
+
+
+
+// Generation
+struct Settings {
+    int    width;
+    int    height;
+    double density;
+    double backlayer_density;
+    int    hitbox_rects = 1;
+
+    std::map<std::string, size_t> entity_counts;
+
+    std::uint64_t seed = DEFAULT_SEED;
+    std::string   out  = DEFAULT_OUT;
+};
+
+nlohmann::json make_tile_layer(int id, const std::string &name, int width, int height, const std::vector<int> &data) {
+    return {
+        { "data", data },
+        { "height", height },
+        { "id", id },
+        { "name", name },
+        { "opacity", 1 },
+        { "type", "tilelayer" },
+        { "visible", true },
+        { "width", width },
+        { "x", 0 },
+        { "y", 0 }
+    };
+}
+
+nlohmann::json generate(const Reference &reference, const Catalog &catalog, const Settings &settings) {
+    Random random(settings.seed);
+
+    const int width  = settings.width;
+    const int height = settings.height;
+
+    const auto index = [&](int X, int Y) { return static_cast<size_t>(Y) * width + X; }; // Tiled stores rows
+
+    std::vector<int>  layer(static_cast<size_t>(width) * height, 0);
+    std::vector<bool> reserved(layer.size(), false);
+
+    // Border is solid, preferring a full-hitbox tile from the reference
+    std::vector<int> full_gids;
+    for (const int gid : reference.layer_palette)
+        if (catalog.gid_is_full.count(gid) && catalog.gid_is_full.at(gid)) full_gids.push_back(gid);
+
+    const auto &border_palette = full_gids.empty() ? reference.layer_palette : full_gids;
+
+    for (int X = 0; X < width; ++X) {
+        layer[index(X, 0)]          = random_pick(random, border_palette);
+        layer[index(X, height - 1)] = random_pick(random, border_palette);
+    }
+    for (int Y = 0; Y < height; ++Y) {
+        layer[index(0, Y)]         = random_pick(random, border_palette);
+        layer[index(width - 1, Y)] = random_pick(random, border_palette);
+    }
+
+    // Spawn area
+    for (int X = width / 2 - SPAWN_AREA_HALF_WIDTH; X <= width / 2 + SPAWN_AREA_HALF_WIDTH; ++X)
+        for (int Y = height / 2 - SPAWN_AREA_HALF_HEIGHT; Y <= height / 2 + SPAWN_AREA_HALF_HEIGHT; ++Y)
+            if (0 < X && X < width - 1 && 0 < Y && Y < height - 1) reserved[index(X, Y)] = true;
+
+    // Interior: floor runs in random order till density is reached, then scattered cells
+    const size_t interior = static_cast<size_t>(std::max(width - 2, 0)) * std::max(height - 2, 0);
+    const size_t target   = static_cast<size_t>(settings.density * interior);
+    size_t       placed   = 0;
+
+    struct Run { int X; int Y; int length; };
+    std::vector<Run> runs;
+
+    for (int Y = FLOOR_SPACING; Y < height - 1; Y += FLOOR_SPACING)
+        for (int X = 1; X < width - 1;) {
+            const int length = std::min(random_int(random, FLOOR_RUN_MIN, FLOOR_RUN_MAX), width - 1 - X);
+            runs.push_back({ X, Y, length });
+            X += length + random_int(random, FLOOR_GAP_MIN, FLOOR_GAP_MAX);
+        }
+
+    for (size_t i = runs.size(); i > 1; --i) std::swap(runs[i - 1], runs[random() % i]); // Fisher-Yates
+
+    const auto place = [&](int X, int Y) {
+        auto &cell = layer[index(X, Y)];
+        if (cell || reserved[index(X, Y)] || placed >= target) return;
+
+        cell = random_pick(random, reference.layer_palette);
+        ++placed;
+    };
+
+    for (const auto &run : runs)
+        for (int X = run.X; X < run.X + run.length; ++X) place(X, run.Y);
+
+    for (size_t attempts = 0; placed < target && attempts < 4 * interior; ++attempts)
+        place(random_int(random, 1, width - 2), random_int(random, 1, height - 2));
+
+    // Backlayer
+    std::vector<int> backlayer(layer.size(), 0);
+
+    if (!reference.backlayer_palette.empty())
+        for (auto &cell : backlayer)
+            if (static_cast<double>(random() >> 11) / (1ull << 53) < settings.backlayer_density)
+                cell = random_pick(random, reference.backlayer_palette);
+
+    // Entities stand on solid cells when possible
+    std::vector<std::pair<int, int>> standing_spots;
+    std::vector<std::pair<int, int>> empty_spots;
+
+    for (int X = 1; X < width - 1; ++X)
+        for (int Y = 1; Y < height - 1; ++Y) {
+            if (layer[index(X, Y)] || reserved[index(X, Y)]) continue;
+
+            empty_spots.push_back({ X, Y });
+            if (layer[index(X, Y + 1)]) standing_spots.push_back({ X, Y });
+        }
+
+    nlohmann::json objects = nlohmann::json::array();
+    int            next_object_id = 1;
+
+    for (const auto &[key, count] : settings.entity_counts) {
+        const int gid = catalog.entity_gids.at(key);
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto &spots = standing_spots.empty() ? empty_spots : standing_spots;
+            if (spots.empty()) break;
+
+            const auto [X, Y] = random_pick(random, spots);
+
+            objects.push_back({
+                { "gid", gid },
+                { "height", TILE_SIZE },
+                { "id", next_object_id++ },
+                { "name", "" },
+                { "rotation", 0 },
+                { "type", "" },
+                { "visible", true },
+                { "width", TILE_SIZE },
+                { "x", X * TILE_SIZE },
+                { "y", (Y + 1) * TILE_SIZE } // Tiled uses bottom-left corner for tile objects
+            });
+        }
+    }
+
+    // Map
+    // - marked as generated, the game ignores unknown properties
+    nlohmann::json properties = reference.properties;
+    properties.push_back(generated_property("like " + reference.name + ", seed " + std::to_string(settings.seed)));
+
+    nlohmann::json map = {
+        { "compressionlevel", -1 },
+        { "height", height },
+        { "infinite", false },
+        { "nextlayerid", 4 },
+        { "nextobjectid", next_object_id },
+        { "orientation", "orthogonal" },
+        { "properties", properties },
+        { "renderorder", "right-down" },
+        { "tiledversion", "1.3.2" },
+        { "tileheight", TILE_SIZE },
+        { "tilesets", reference.tilesets },
+        { "tilewidth", TILE_SIZE },
+        { "type", "map" },
+        { "version", 1.2 },
+        { "width", width }
+    };
+
+    map["layers"] = nlohmann::json::array({
+        make_tile_layer(1, "[backlayer]", width, height, backlayer),
+        make_tile_layer(2, "[layer]", width, height, layer),
+        {
+            { "draworder", "topdown" },
+            { "id", 3 },
+            { "name", "[entity]" },
+            { "objects", objects },
+            { "opacity", 1 },
+            { "type", "objectgroup" },
+            { "visible", true },
+            { "x", 0 },
+            { "y", 0 }
+        }
+    });
+
+    std::cout
+        << "- Generated level -\n"
+        << "Reference:         " << reference.name << "\n"
+        << "Size:              " << width << " x " << height << " (" << width * height << " cells)\n"
+        << "Logic tiles:       " << layer.size() - std::count(layer.begin(), layer.end(), 0) << " (density " << settings.density << ")\n"
+        << "Entities:          " << objects.size() << "\n"
+        << "Hitbox rects:      x" << settings.hitbox_rects << "\n";
+
+    return map;
+}
+
+int main(int argc, char* argv[]) {
+    std::string like;
+    double      scale = 1.;
+
+    int    width             = 0; // 0 means "take from reference"
+    int    height            = 0;
+    double density           = -1.;
+    int    hitbox_rects      = 1;
+    std::map<std::string, size_t> entity_overrides;
+
+    Settings settings;
+
+    for (int i = 1; i < argc; i += 2) {
+        const std::string key = argv[i];
+
+        if (i + 1 == argc) {
+            std::cout << "Error: Argument '" << key << "' requires a value.\n";
+            return -1;
+        }
+
+        const std::string value = argv[i + 1];
+
+        try {
+            if (key == "--like") like = value;
+            else if (key == "--scale") scale = std::stod(value);
+            else if (key == "--width") width = std::stoi(value);
+            else if (key == "--height") height = std::stoi(value);
+            else if (key == "--density") density = std::stod(value);
+            else if (key == "--hitbox-rects") hitbox_rects = std::max(std::stoi(value), 1);
+            else if (key == "--seed") settings.seed = std::stoull(value);
+            else if (key == "--out") settings.out = value;
+            else if (key == "--entity") {
+                const size_t separator = value.find('=');
+                if (separator == std::string::npos) {
+                    std::cout << "Error: '--entity' expects '<type-name>=<count>', got '" << value << "'.\n";
+                    return -1;
+                }
+                entity_overrides[value.substr(0, separator)] = std::stoull(value.substr(separator + 1));
+            }
+            else {
+                std::cout << "Error: Unknown argument '" << key << "'.\n";
+                return -1;
+            }
+        }
+        catch (const std::logic_error &) { // 'invalid_argument' or 'out_of_range'
+            std::cout << "Error: Invalid value '" << value << "' of argument '" << key << "'.\n";
+            return -1;
+        }
+    }
+
+    if (settings.out.empty() || settings.out.find_first_of("/\\") != std::string::npos) {
+        std::cout << "Error: '--out' expects a plain level name, got '" << settings.out << "'.\n";
+        return -1;
+    }
+
+    // Reference
+    if (like.empty()) like = find_heaviest_level();
+
+    Reference reference;
+    if (like.empty() || !load_reference(like, reference)) {
+        std::cout << "Error: Could not load reference level '" << like << "'.\n";
+        return -1;
+    }
+
+    const Catalog catalog = load_catalog(reference);
+
+    // Settings, scale applies to area so both sides grow by its root
+    const double side_scale = std::sqrt(std::max(scale, 0.));
+
+    settings.width             = width ? width : std::max(static_cast<int>(std::round(reference.width * side_scale)), 3);
+    settings.height            = height ? height : std::max(static_cast<int>(std::round(reference.height * side_scale)), 3);
+    settings.density           = (density >= 0.) ? std::min(density, 1.) : reference.layer_density;
+    settings.backlayer_density = reference.backlayer_density;
+    settings.hitbox_rects      = hitbox_rects;
+
+    for (const int gid : reference.entity_gids) {
+        const auto key = catalog.gid_entities.find(gid);
+        if (key != catalog.gid_entities.end()) settings.entity_counts[key->second] += 1;
+    }
+    for (auto &[key, count] : settings.entity_counts) count = static_cast<size_t>(std::round(count * scale));
+
+    for (const auto &[key, count] : entity_overrides) {
+        if (!catalog.entity_gids.count(key)) {
+            std::cout << "Error: Entity '" << key << "' isn't present in tilesets of '" << reference.name << "', available:\n";
+            for (const auto &[available, gid] : catalog.entity_gids) std::cout << "  " << available << "\n";
+            return -1;
+        }
+        settings.entity_counts[key] = count;
+    }
+
+    // Generate
+    const std::string out_filepath = PATH_LEVELS_GENERATED + settings.out + ".json";
+
+    if (!can_overwrite(out_filepath)) return -1; // checked first so nothing is written if the map can't be
+
+    if (settings.hitbox_rects > 1 && !write_sliced_tilesets(reference, settings.hitbox_rects)) {
+        std::cout << "Error: Could not write sliced tilesets.\n";
+        return -1;
+    }
+
+    auto map = generate(reference, catalog, settings);
+
+    // Map lives a directory deeper than its reference, Tiled resolves tileset sources relative to the map
+    for (auto &tileset_node : map["tilesets"]) tileset_node["source"] = "../../tilesets/" + tileset_filename(tileset_node);
+
+    std::filesystem::create_directories(PATH_LEVELS_GENERATED);
+
+    std::ofstream file(out_filepath);
+    file << map.dump() << "\n";
+
+    if (!file) {
+        std::cout << "Error: Could not write '" << out_filepath << "'.\n";
+        return -1;
+    }
+
+    std::cout << "Level written to '" << out_filepath << "', load it as 'generated/" << settings.out << "'\n";
+
+    return 0;
+}
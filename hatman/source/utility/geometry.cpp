@@ -2,16 +2,28 @@
 
 
 
+static RandomGenerator _fallback_generator;
+static RandomGenerator* _bound_generator = &_fallback_generator;
+
+void rand_bind(RandomGenerator* generator) {
+	_bound_generator = generator ? generator : &_fallback_generator;
+}
+
+RandomGenerator& rand_generator() {
+	return *_bound_generator;
+}
+
 bool rand_bool() {
-	return static_cast<bool>(rand() % 2);
+	return static_cast<bool>(rand_generator()() >> 63); // top bits are the best ones for xoshiro
 }
 
 int rand_int(int min, int max) {
-	return min + rand() % (max - min + 1);
+	if (min >= max) return min;
+	return utl::random::UniformIntDistribution<int>(min, max)(rand_generator());
 }
 
 double rand_double() {
-	return rand() / (RAND_MAX + 1.);
+	return 1. - utl::random::generate_canonical<double>(rand_generator()); // [0, 1) -> (0, 1]
 }
 
 double rand_double(double min, double max) {